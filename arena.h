@@ -0,0 +1,280 @@
+// arena.h
+#ifndef ARENA_H
+#define ARENA_H
+
+#include "gameLogic.h"
+#include "workPool.h"
+
+// ============================================================================
+// MULTI-SNAKE ARENA
+// ============================================================================
+//
+// Many snakes on one board with several food items. A tick runs in three
+// phases so the outcome never depends on the order snakes are visited:
+//
+//   A. Propose (parallel): each snake applies its input, computes its next
+//      head, stamps its tail cell as vacated unless it will grow, and claims
+//      the head cell by bumping a per-cell counter in the claim table.
+//   B. Resolve (parallel): a head on a cell claimed more than once dies
+//      head-on (shared food included: nobody gets it); a head entering a
+//      SNAKE cell that is not stamped as vacated this tick dies in a body.
+//      Both are a constant number of table lookups per snake.
+//   C. Apply (serial): dead snakes leave the board, survivors release
+//      their tails and then push their heads, and eaten food is replaced.
+//      The board's free list has a single writer, and this phase is a few
+//      cell writes per snake.
+//
+// Both tables are stamped with the tick rather than cleared, so a tick
+// costs O(snakes), not O(cells).
+
+/**
+ * @brief Why an arena snake died.
+ */
+enum ArenaDeath {
+    ARENA_ALIVE = 0,
+    ARENA_HIT_WALL = 1,              ///< Left the board or entered a wall
+    ARENA_HIT_SNAKE = 2,             ///< Entered a body cell (its own or another's)
+    ARENA_HEAD_ON = 3                ///< Another head entered the same cell
+};
+
+/**
+ * @brief Board shared by many snakes, resolved two-phase per tick.
+ *
+ * Snake ids are slots in [0, maxSnakes); a dead snake's slot is reused by
+ * addSnake(). Directions are queued per snake through the same
+ * DirectionController the single-snake game uses. With a pool the propose
+ * and resolve phases run across its workers; the result is identical to a
+ * serial step.
+ *
+ * BoardT must be dense (it needs the free list for food placement).
+ */
+template<typename BoardT = Board>
+class BasicSnakeArena {
+    static_assert(!BoardT::IS_SPARSE, "The arena places food from the board's free list");
+
+public:
+    using BoardType = BoardT;
+
+private:
+    struct ArenaSnake {
+        Snake snake;
+        int score = 0;
+        ArenaDeath death = ARENA_ALIVE;
+        bool alive = false;
+    };
+
+    /// Per-live-snake result of the propose and resolve phases
+    struct Proposal {
+        int32_t head;                ///< Next head cell, -1 if it leaves the board
+        ArenaDeath death;
+        bool eats;
+    };
+
+    BoardT board;
+    vector<ArenaSnake> snakes;
+    unique_ptr<DirectionController[]> controllers;
+    vector<uint32_t> live;           ///< Ids of living snakes, in the order phase C applies them
+    vector<Proposal> proposals;      ///< Indexed like `live`
+    vector<uint64_t> claims;         ///< Per cell: (tick << 32) | heads claiming it this tick
+    vector<uint32_t> vacated;        ///< Per cell: the last tick a tail left it
+
+    GameRandom rng;
+    int foodTarget;
+    int foodCount;
+    int pointsPerFood;
+    uint32_t tick;
+
+    static constexpr uint32_t GRAIN = 64;
+
+    void propose(uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; i++) {
+            uint32_t id = live[i];
+            Snake& snake = snakes[id].snake;
+            DirectionController& controller = controllers[id];
+            controller.processInput();
+
+            Proposal& proposal = proposals[i];
+            pair<int, int> next = controller.getNextPosition(snake.getHead());
+            if (!board.isInBounds(next.first, next.second) ||
+                board.getCellType(next.first, next.second) == WALL) {
+                proposal = {-1, ARENA_HIT_WALL, false};
+                continue;
+            }
+
+            int head = board.toIndex(next.first, next.second);
+            bool eats = board.getCell(head) == FOOD;
+            proposal = {head, ARENA_ALIVE, eats};
+            if (!eats && !snake.hasPendingGrowth()) {
+                vacated[snake.getTailIndex()] = tick;
+            }
+
+            // Bump this tick's claim count; a stale stamp counts as zero
+            atomic_ref<uint64_t> claim(claims[head]);
+            uint64_t seen = claim.load(memory_order_relaxed);
+            uint64_t stamp = static_cast<uint64_t>(tick) << 32;
+            uint64_t wanted;
+            do {
+                wanted = (seen & ~0xFFFFFFFFull) == stamp ? seen + 1 : stamp | 1;
+            } while (!claim.compare_exchange_weak(seen, wanted, memory_order_relaxed));
+        }
+    }
+
+    void resolve(uint32_t begin, uint32_t end) {
+        uint64_t single = (static_cast<uint64_t>(tick) << 32) | 1;
+        for (uint32_t i = begin; i < end; i++) {
+            Proposal& proposal = proposals[i];
+            if (proposal.head < 0) continue;
+            if (claims[proposal.head] != single) {
+                proposal.death = ARENA_HEAD_ON;
+            } else if (board.getCell(proposal.head) == SNAKE && vacated[proposal.head] != tick) {
+                proposal.death = ARENA_HIT_SNAKE;
+            }
+        }
+    }
+
+    void placeFood() {
+        while (foodCount < foodTarget) {
+            int freeCount = board.getFreeCellCount();
+            if (freeCount == 0) return;
+            board.setCell(board.getFreeCell(static_cast<int>(rng.below(static_cast<uint32_t>(freeCount)))), FOOD);
+            foodCount++;
+        }
+    }
+
+public:
+    BasicSnakeArena() : foodTarget(0), foodCount(0), pointsPerFood(10), tick(0) {}
+
+    /**
+     * @brief Clears the board and removes every snake.
+     * @param rows Number of rows (ignored with compile-time dimensions)
+     * @param cols Number of columns (ignored with compile-time dimensions)
+     * @param maxSnakes Snake slots to reserve
+     * @param foodItems Food kept on the board while there is room
+     * @param points Points per food eaten
+     * @param seed Seed for food placement
+     */
+    void initialize(int rows, int cols, int maxSnakes, int foodItems, int points, uint32_t seed) {
+        board.initialize(rows, cols);
+        size_t cellCount = static_cast<size_t>(board.getCellCount());
+
+        if (snakes.size() != static_cast<size_t>(maxSnakes)) {
+            snakes.assign(static_cast<size_t>(maxSnakes), ArenaSnake());
+            controllers = make_unique<DirectionController[]>(static_cast<size_t>(maxSnakes));
+            for (ArenaSnake& entry : snakes) entry.snake.setCompactRing(true);
+        } else {
+            for (ArenaSnake& entry : snakes) entry.alive = false;
+        }
+        live.clear();
+        live.reserve(static_cast<size_t>(maxSnakes));
+        proposals.resize(static_cast<size_t>(maxSnakes));
+        claims.assign(cellCount, 0);
+        vacated.assign(cellCount, 0);
+
+        rng.seed(seed);
+        foodTarget = foodItems;
+        foodCount = 0;
+        pointsPerFood = points;
+        tick = 1;                    // Stamps of 0 mean "never"
+        placeFood();
+    }
+
+    /**
+     * @brief Adds a straight snake with its head at (row, col), trailing
+     * opposite to `direction`.
+     * @return The snake's id, or -1 if there is no free slot or any of its
+     *         cells is off the board or not EMPTY
+     */
+    int addSnake(int row, int col, int length, Direction direction) {
+        if (length <= 0 || direction == NONE) return -1;
+        int dr = direction == UP ? 1 : direction == DOWN ? -1 : 0;
+        int dc = direction == LEFT ? 1 : direction == RIGHT ? -1 : 0;
+        for (int i = 0; i < length; i++) {
+            if (board.getCellType(row + dr * i, col + dc * i) != EMPTY) return -1;
+        }
+
+        for (size_t id = 0; id < snakes.size(); id++) {
+            ArenaSnake& entry = snakes[id];
+            if (entry.alive) continue;
+            entry.snake.initialize({row, col}, length, direction, board);
+            entry.score = 0;
+            entry.death = ARENA_ALIVE;
+            entry.alive = true;
+            controllers[id].initialize(direction);
+            live.push_back(static_cast<uint32_t>(id));
+            return static_cast<int>(id);
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Queues a direction press for one snake (thread-safe for one
+     * input thread per snake).
+     */
+    bool setDirection(int id, Direction direction) {
+        return controllers[id].setInput(direction);
+    }
+
+    /**
+     * @brief Advances every living snake by one tick.
+     * @param pool Runs the propose and resolve phases; serial if null
+     */
+    void step(WorkStealingPool* pool = nullptr) {
+        uint32_t count = static_cast<uint32_t>(live.size());
+        if (pool) {
+            pool->parallelFor(count, GRAIN, [this](uint32_t begin, uint32_t end, unsigned) {
+                propose(begin, end);
+            });
+            pool->parallelFor(count, GRAIN, [this](uint32_t begin, uint32_t end, unsigned) {
+                resolve(begin, end);
+            });
+        } else {
+            propose(0, count);
+            resolve(0, count);
+        }
+
+        // Dead bodies go first, so their cells are free for this tick's heads
+        for (uint32_t i = 0; i < count; i++) {
+            if (proposals[i].death == ARENA_ALIVE) continue;
+            ArenaSnake& entry = snakes[live[i]];
+            entry.snake.removeFrom(board);
+            entry.death = proposals[i].death;
+            entry.alive = false;
+        }
+        // Every tail leaves before any head arrives, so heads may follow tails
+        for (uint32_t i = 0; i < count; i++) {
+            if (proposals[i].death != ARENA_ALIVE) continue;
+            ArenaSnake& entry = snakes[live[i]];
+            if (proposals[i].eats) {
+                entry.snake.grow();
+                entry.score += pointsPerFood;
+                foodCount--;
+            }
+            entry.snake.releaseTail(board);
+        }
+        size_t kept = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (proposals[i].death != ARENA_ALIVE) continue;
+            snakes[live[i]].snake.pushHead(proposals[i].head, board);
+            live[kept++] = live[i];
+        }
+        live.resize(kept);
+
+        placeFood();
+        tick++;
+    }
+
+    const BoardT& getBoard() const { return board; }
+    const Snake& getSnake(int id) const { return snakes[id].snake; }
+    bool isAlive(int id) const { return snakes[id].alive; }
+    int getScore(int id) const { return snakes[id].score; }
+    ArenaDeath getDeath(int id) const { return snakes[id].death; }
+    Direction getDirection(int id) const { return controllers[id].getCurrent(); }
+    int getMaxSnakes() const { return static_cast<int>(snakes.size()); }
+    int getAliveCount() const { return static_cast<int>(live.size()); }
+    int getFoodCount() const { return foodCount; }
+    uint32_t getTick() const { return tick - 1; }
+};
+
+using SnakeArena = BasicSnakeArena<Board>;
+
+#endif // ARENA_H
@@ -0,0 +1,395 @@
+// autopilot.h
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "gameLogic.h"
+
+// ============================================================================
+// AUTOPILOT
+// ============================================================================
+
+/**
+ * @brief How the autopilot plays.
+ */
+enum AutopilotMode {
+    AUTOPILOT_OFF = 0,
+    AUTOPILOT_GREEDY = 1,        ///< Shortest safe path to the food, tail-chasing otherwise
+    AUTOPILOT_HAMILTONIAN = 2    ///< Follow a Hamiltonian cycle; never dies, always fills the board
+};
+
+/**
+ * @brief Automated player for soak tests and baselines.
+ *
+ * decide() looks at a simulation and returns the direction to press.
+ * Greedy mode runs a BFS from the head to the food and takes it only if,
+ * after eating, the snake could still reach its own tail; otherwise it
+ * chases its tail, and when even that is cut off it heads for the largest
+ * open area. The searches know when each body segment moves out of the
+ * way, so a path may run through cells the tail will have vacated by then.
+ *
+ * Hamiltonian mode follows a cycle through every cell (boards with an even
+ * side), which fills the board without ever dying; moves the cycle cannot
+ * make safely, e.g. right after the start, fall back to greedy.
+ *
+ * Every search runs over scratch arrays sized once per board size:
+ * visited stamps (reset by bumping a counter), parent and distance arrays,
+ * and a FIFO of cell indices. decide() never allocates mid-game.
+ */
+class Autopilot {
+private:
+    static constexpr Direction DIRECTIONS[4] = {UP, DOWN, LEFT, RIGHT};
+
+    AutopilotMode mode;
+    int rows;
+    int cols;
+    int cellCount;
+
+    // BFS scratch, valid where visited[cell] == visitMark
+    vector<uint32_t> visited;
+    vector<int32_t> parent;
+    vector<int32_t> distance;
+    vector<int32_t> queue;
+    uint32_t visitMark;
+
+    // Body of the snake being searched around: where bodyStamp[cell] ==
+    // bodyMark, the cell is occupied for freeAfter[cell] more ticks
+    vector<uint32_t> bodyStamp;
+    vector<int32_t> freeAfter;
+    vector<int32_t> body;
+    int bodyLength;
+    uint32_t bodyMark;
+
+    // Path to the food, head excluded, in move order
+    vector<int32_t> path;
+
+    // Ticks spent chasing the tail since the last safe path to the food
+    int chaseTicks;
+    uint64_t lastTick;
+
+    // Hamiltonian cycle: cycleCells[k] is the k-th cell, cycleOrder its inverse
+    vector<int32_t> cycleCells;
+    vector<int32_t> cycleOrder;
+    bool hasCycle;
+
+    static uint32_t bump(vector<uint32_t>& stamps, uint32_t& mark) {
+        if (++mark == 0) {
+            fill(stamps.begin(), stamps.end(), 0u);
+            mark = 1;
+        }
+        return mark;
+    }
+
+    static Direction opposite(Direction direction) {
+        switch (direction) {
+            case UP:    return DOWN;
+            case DOWN:  return UP;
+            case LEFT:  return RIGHT;
+            case RIGHT: return LEFT;
+            case NONE:  break;
+        }
+        return NONE;
+    }
+
+    /// Neighbor index in a direction, or -1 past the edge
+    int neighbor(int index, Direction direction) const {
+        int r = index / cols;
+        int c = index - r * cols;
+        switch (direction) {
+            case UP:    return r > 0 ? index - cols : -1;
+            case DOWN:  return r + 1 < rows ? index + cols : -1;
+            case LEFT:  return c > 0 ? index - 1 : -1;
+            case RIGHT: return c + 1 < cols ? index + 1 : -1;
+            case NONE:  break;
+        }
+        return -1;
+    }
+
+    Direction directionTo(int from, int to) const {
+        if (to == from - cols) return UP;
+        if (to == from + cols) return DOWN;
+        if (to == from - 1) return LEFT;
+        if (to == from + 1) return RIGHT;
+        return NONE;
+    }
+
+    void buildCycle() {
+        hasCycle = false;
+        if (rows < 2 || cols < 2 || (rows % 2 != 0 && cols % 2 != 0)) return;
+
+        // Serpentine over all but the first column (or row), back along it
+        int k = 0;
+        if (rows % 2 == 0) {
+            for (int r = 0; r < rows; r++) {
+                for (int i = 1; i < cols; i++) {
+                    cycleCells[k++] = r * cols + (r % 2 == 0 ? i : cols - i);
+                }
+            }
+            for (int r = rows - 1; r >= 0; r--) cycleCells[k++] = r * cols;
+        } else {
+            for (int c = 0; c < cols; c++) {
+                for (int i = 1; i < rows; i++) {
+                    cycleCells[k++] = (c % 2 == 0 ? i : rows - i) * cols + c;
+                }
+            }
+            for (int c = cols - 1; c >= 0; c--) cycleCells[k++] = c;
+        }
+        for (int i = 0; i < cellCount; i++) cycleOrder[cycleCells[i]] = i;
+        hasCycle = true;
+    }
+
+    /**
+     * @brief Makes body[0, length) the snake the searches avoid.
+     */
+    void markBody(int length) {
+        bodyLength = length;
+        bump(bodyStamp, bodyMark);
+        for (int i = 0; i < length; i++) {
+            bodyStamp[body[i]] = bodyMark;
+            freeAfter[body[i]] = length - i;
+        }
+    }
+
+    template<typename BoardT>
+    bool isPassable(const BoardT& board, int index, int tick) const {
+        if (bodyStamp[index] == bodyMark) return freeAfter[index] <= tick;
+        return board.getCell(index) != WALL;
+    }
+
+    /**
+     * @brief BFS from the marked body's head.
+     * @param target Cell to stop at, or -1 to explore everything reachable
+     * @param banned First move that is not allowed (the reverse), or NONE
+     * @return Distance to target (-1 if unreachable), or the number of cells reached
+     */
+    template<typename BoardT>
+    int search(const BoardT& board, int target, Direction banned) {
+        int start = body[0];
+        bump(visited, visitMark);
+        visited[start] = visitMark;
+        parent[start] = -1;
+        distance[start] = 0;
+
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = start;
+        while (head < tail) {
+            int cell = queue[head++];
+            int next = distance[cell] + 1;
+            int r = cell / cols;
+            int c = cell - r * cols;
+            const int neighbors[4] = {r > 0 ? cell - cols : -1, r + 1 < rows ? cell + cols : -1,
+                                      c > 0 ? cell - 1 : -1, c + 1 < cols ? cell + 1 : -1};
+            for (int d = 0; d < 4; d++) {
+                int n = neighbors[d];
+                if (cell == start && DIRECTIONS[d] == banned) continue;
+                if (n < 0 || visited[n] == visitMark || !isPassable(board, n, next)) continue;
+                visited[n] = visitMark;
+                parent[n] = cell;
+                distance[n] = next;
+                if (n == target) return next;
+                queue[tail++] = n;
+            }
+        }
+        return target < 0 ? tail - 1 : -1;
+    }
+
+    /**
+     * @brief Replaces the marked body with where it will be after `moves`.
+     * @param moves Cells the head enters, in order
+     * @param eats Whether the last move eats (the tail stays put that tick)
+     */
+    void advanceBody(const int32_t* moves, int moveCount, bool eats) {
+        int length = bodyLength + (eats ? 1 : 0);
+        int kept = max(0, length - moveCount);
+        // Shift the surviving segments back, then write the new head cells in front
+        for (int i = kept - 1; i >= 0; i--) {
+            body[min(moveCount, length) + i] = body[i];
+        }
+        int written = min(moveCount, length);
+        for (int i = 0; i < written; i++) {
+            body[i] = moves[moveCount - 1 - i];
+        }
+        markBody(length);
+    }
+
+    template<typename Simulation>
+    void loadBody(const Simulation& game) {
+        SnakeBodyView view = game.getSnake().getBody();
+        int length = static_cast<int>(view.size());
+        for (int i = 0; i < length; i++) {
+            body[i] = static_cast<int32_t>(view[i]);
+        }
+        markBody(length);
+    }
+
+    /**
+     * @brief Shortest path to the food, if after eating the tail is still reachable.
+     * @param checkSafety False to take the path even if eating traps the snake
+     */
+    template<typename Simulation>
+    Direction toFood(const Simulation& game, int food, Direction banned, bool checkSafety) {
+        const auto& board = game.getBoard();
+        int steps = search(board, food, banned);
+        if (steps < 0) return NONE;
+
+        for (int cell = food, i = steps - 1; i >= 0; cell = parent[cell], i--) {
+            path[i] = cell;
+        }
+        Direction first = directionTo(body[0], path[0]);
+
+        // A move that fills the board cannot be unsafe
+        if (!checkSafety || board.getFreeCellCount() == 1) return first;
+
+        advanceBody(path.data(), steps, true);
+        bool safe = search(board, body[bodyLength - 1], NONE) > 0;
+
+        loadBody(game);
+        return safe ? first : NONE;
+    }
+
+    /**
+     * @brief Best single move when the food is not safely reachable.
+     *
+     * Prefers the move from which the tail is furthest (following it buys
+     * the most time); failing that, the move into the largest open area.
+     */
+    template<typename Simulation>
+    Direction survive(const Simulation& game, int food, Direction banned) {
+        const auto& board = game.getBoard();
+        Direction chase = NONE;
+        int chaseDistance = 0;
+        Direction roomiest = NONE;
+        int room = -1;
+
+        for (Direction direction : DIRECTIONS) {
+            if (direction == banned) continue;
+            int n = neighbor(body[0], direction);
+            if (n < 0 || !isPassable(board, n, 1)) continue;
+
+            int32_t move = n;
+            advanceBody(&move, 1, n == food);
+            int toTail = search(board, body[bodyLength - 1], NONE);
+            if (toTail > chaseDistance) {
+                chase = direction;
+                chaseDistance = toTail;
+            }
+            if (chase == NONE) {
+                int area = search(board, -1, NONE);
+                if (area > room) {
+                    roomiest = direction;
+                    room = area;
+                }
+            }
+            loadBody(game);
+        }
+        return chase != NONE ? chase : roomiest;
+    }
+
+    template<typename Simulation>
+    Direction decideGreedy(const Simulation& game, Direction banned) {
+        const auto& foodManager = game.getFoodManager();
+        int food = -1;
+        if (foodManager.isPresent()) {
+            pair<int, int> position = foodManager.getPosition();
+            food = game.getBoard().toIndex(position.first, position.second);
+
+            // Chasing the tail can cycle forever; after two laps' worth of
+            // ticks, go for the food even if it is a gamble
+            bool checkSafety = chaseTicks < 2 * cellCount;
+            Direction direction = toFood(game, food, banned, checkSafety);
+            if (direction != NONE) {
+                chaseTicks = 0;
+                return direction;
+            }
+            chaseTicks++;
+        }
+        return survive(game, food, banned);
+    }
+
+public:
+    explicit Autopilot(AutopilotMode autopilotMode = AUTOPILOT_GREEDY)
+        : mode(autopilotMode), rows(0), cols(0), cellCount(0), visitMark(0),
+          bodyLength(0), bodyMark(0), chaseTicks(0), lastTick(0), hasCycle(false) {}
+
+    void setMode(AutopilotMode autopilotMode) { mode = autopilotMode; }
+    AutopilotMode getMode() const { return mode; }
+
+    /**
+     * @brief Sizes the scratch buffers for a board; decide() calls it when the size changes.
+     */
+    void reserve(int boardRows, int boardCols) {
+        if (boardRows == rows && boardCols == cols) return;
+        rows = boardRows;
+        cols = boardCols;
+        cellCount = rows * cols;
+        size_t cells = static_cast<size_t>(cellCount);
+
+        visited.assign(cells, 0u);
+        parent.assign(cells, -1);
+        distance.assign(cells, 0);
+        queue.assign(cells, 0);
+        bodyStamp.assign(cells, 0u);
+        freeAfter.assign(cells, 0);
+        body.assign(cells + 1, 0);
+        path.assign(cells, 0);
+        cycleCells.assign(cells, 0);
+        cycleOrder.assign(cells, 0);
+        visitMark = 0;
+        bodyMark = 0;
+        buildCycle();
+    }
+
+    /**
+     * @brief Direction to press this tick.
+     * @param game Simulation to look at (BasicSnakeSimulation over any board)
+     * @return Direction for setDirection(), or NONE when the game is over or every move loses
+     */
+    template<typename Simulation>
+    Direction decide(const Simulation& game) {
+        if (mode == AUTOPILOT_OFF || game.isGameOver() || game.getSnake().getLength() == 0) return NONE;
+
+        reserve(game.getBoard().getRows(), game.getBoard().getCols());
+        if (game.getTick() < lastTick) chaseTicks = 0;    // A new game
+        lastTick = game.getTick();
+        const Snake& snake = game.getSnake();
+        Direction banned = snake.getLength() > 1 ? opposite(game.getDirection()) : NONE;
+
+        // On the cycle the board alone says whether the next cell is free
+        if (mode == AUTOPILOT_HAMILTONIAN && hasCycle) {
+            int head = static_cast<int>(snake.getHeadIndex());
+            int next = cycleCells[(cycleOrder[head] + 1) % cellCount];
+            Direction direction = directionTo(head, next);
+            int cell = game.getBoard().getCell(next);
+            bool free = cell == EMPTY || cell == FOOD ||
+                        (cell == SNAKE && static_cast<uint32_t>(next) == snake.getTailIndex());
+            if (direction != banned && free) return direction;
+        }
+
+        loadBody(game);
+        return decideGreedy(game, banned);
+    }
+
+    bool hasHamiltonianCycle() const { return hasCycle; }
+};
+
+/**
+ * @brief SimulationRunner policy with one Autopilot per worker.
+ *
+ * Runner policies are called from every worker at once, so each worker
+ * gets its own scratch buffers (indexed by the context's worker).
+ */
+class AutopilotPolicy {
+private:
+    vector<Autopilot> pilots;
+
+public:
+    AutopilotPolicy(unsigned workers, AutopilotMode mode = AUTOPILOT_GREEDY)
+        : pilots(workers, Autopilot(mode)) {}
+
+    template<typename Simulation, typename Context>
+    Direction operator()(const Simulation& game, Context& context) {
+        return pilots[context.worker].decide(game);
+    }
+};
+
+#endif // AUTOPILOT_H
@@ -0,0 +1,172 @@
+// batchEnv.h
+#ifndef BATCHENV_H
+#define BATCHENV_H
+
+#include "gameLogic.h"
+
+/**
+ * @brief Settings shared by every environment in a BatchSnakeEnv.
+ */
+struct BatchEnvConfig {
+    int rows = 20;
+    int cols = 40;
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    Direction initialDirection = RIGHT;
+    uint32_t seed = 1;               ///< Master seed; each episode's seed is derived from it
+    int maxEpisodeTicks = 0;         ///< Truncate episodes after this many ticks; 0 = never
+    float foodReward = 1.0f;         ///< Reward for a tick that eats food
+    float deathPenalty = -1.0f;      ///< Reward for a tick that ends in a collision
+    float stepReward = 0.0f;         ///< Reward for every other tick
+};
+
+// ============================================================================
+// BATCH ENVIRONMENT
+// ============================================================================
+
+/**
+ * @brief Headless, vectorized driver for N independent snake games.
+ *
+ * Each environment is a SnakeSimulation, so ticks follow exactly the same
+ * rules as SnakeGameLogic::update() but without snapshots or publishing.
+ * Per-episode bookkeeping is kept in structure-of-arrays form. Finished
+ * episodes are reset inside step(), so observations taken after a step that
+ * reported done already show the next episode's first state.
+ */
+class BatchSnakeEnv {
+public:
+    /// Observation planes per environment: snake body (incl. head), head, food
+    static constexpr int OBSERVATION_PLANES = 3;
+
+private:
+    BatchEnvConfig config;
+    int count;
+    unique_ptr<SnakeSimulation[]> games;
+
+    vector<int32_t> episodeTicks;
+    vector<int32_t> lastEpisodeScore;
+    vector<int32_t> lastEpisodeTicks;
+    vector<uint32_t> episodeIndex;
+    uint64_t completedEpisodes;
+
+    // Stream (env, episode) of the master seed: reproducible regardless of reset order
+    uint32_t episodeSeed(int i) const {
+        return deriveStreamSeed(config.seed, (static_cast<uint64_t>(i) << 32) | episodeIndex[i]);
+    }
+
+    void resetEnv(int i) {
+        games[i].initialize(config.rows, config.cols, config.startingLength,
+                            config.pointsPerFood, config.initialDirection, episodeSeed(i));
+        episodeIndex[i]++;
+        episodeTicks[i] = 0;
+    }
+
+public:
+    /**
+     * @brief Creates and resets `count` environments.
+     * @param count Number of environments
+     * @param config Shared settings
+     */
+    BatchSnakeEnv(int count, const BatchEnvConfig& config)
+        : config(config), count(count), games(make_unique<SnakeSimulation[]>(count)),
+          episodeTicks(count, 0), lastEpisodeScore(count, 0), lastEpisodeTicks(count, 0),
+          episodeIndex(count, 0), completedEpisodes(0) {
+        reset();
+    }
+
+    /**
+     * @brief Starts a fresh episode in every environment.
+     */
+    void reset() {
+        for (int i = 0; i < count; i++) {
+            resetEnv(i);
+        }
+    }
+
+    /**
+     * @brief Advances every environment by one tick.
+     * @param actions One direction per environment (NONE keeps going straight)
+     * @param rewards Receives one reward per environment
+     * @param dones Receives 1 where the episode ended this tick (and was reset)
+     */
+    void step(const Direction* actions, float* rewards, uint8_t* dones) {
+        GameDelta delta;
+
+        for (int i = 0; i < count; i++) {
+            SnakeSimulation& game = games[i];
+            if (actions[i] != NONE) {
+                game.setDirection(actions[i]);
+            }
+
+            bool alive = game.step(delta);
+            episodeTicks[i]++;
+
+            float reward = config.stepReward;
+            if (delta.scoreDelta > 0) reward = config.foodReward;
+            // A game over with a head move is a full-board win, not a death
+            if (!alive && delta.headAdded < 0) reward = config.deathPenalty;
+
+            bool truncated = config.maxEpisodeTicks > 0 && episodeTicks[i] >= config.maxEpisodeTicks;
+            bool done = !alive || truncated;
+            rewards[i] = reward;
+            dones[i] = done ? 1 : 0;
+
+            if (done) {
+                lastEpisodeScore[i] = game.getScore();
+                lastEpisodeTicks[i] = episodeTicks[i];
+                completedEpisodes++;
+                resetEnv(i);
+            }
+        }
+    }
+
+    /**
+     * @brief Writes observations for every environment into one buffer.
+     *
+     * Layout is [env][plane][row][col], contiguous, with 1 for set cells and
+     * 0 elsewhere. The buffer must hold getObservationSize() elements.
+     * @param out Caller-provided buffer (e.g. float or uint8_t)
+     */
+    template<typename T>
+    void writeObservations(T* out) const {
+        size_t cellCount = static_cast<size_t>(config.rows) * config.cols;
+
+        for (int i = 0; i < count; i++) {
+            const Board& board = games[i].getBoard();
+            const uint8_t* cells = board.data();
+            T* snakePlane = out;
+            T* headPlane = out + cellCount;
+            T* foodPlane = out + 2 * cellCount;
+
+            for (size_t c = 0; c < cellCount; c++) {
+                snakePlane[c] = static_cast<T>(cells[c] == SNAKE);
+                headPlane[c] = static_cast<T>(0);
+                foodPlane[c] = static_cast<T>(cells[c] == FOOD);
+            }
+
+            const Snake& snake = games[i].getSnake();
+            if (snake.getLength() > 0) {
+                headPlane[snake.getHeadIndex()] = static_cast<T>(1);
+            }
+
+            out += OBSERVATION_PLANES * cellCount;
+        }
+    }
+
+    /**
+     * @brief Number of elements writeObservations() needs for all environments.
+     */
+    size_t getObservationSize() const {
+        return static_cast<size_t>(count) * OBSERVATION_PLANES * config.rows * config.cols;
+    }
+
+    int size() const { return count; }
+    const SnakeSimulation& getGame(int i) const { return games[i]; }
+    int getEpisodeTicks(int i) const { return episodeTicks[i]; }
+    int getLastEpisodeScore(int i) const { return lastEpisodeScore[i]; }
+    int getLastEpisodeTicks(int i) const { return lastEpisodeTicks[i]; }
+    uint64_t getCompletedEpisodes() const { return completedEpisodes; }
+    const BatchEnvConfig& getConfig() const { return config; }
+};
+
+#endif // BATCHENV_H
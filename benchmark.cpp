@@ -0,0 +1,760 @@
+#include "gameApp.h"
+#include "arena.h"
+#include "broadcast.h"
+#include "checkpoint.h"
+#include "searchState.h"
+#include "simRunner.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace std;
+
+// ============================================
+// Allocation Counting
+// ============================================
+
+static atomic<uint64_t> allocationCount{0};
+
+// Results are stored here so the optimizer cannot drop the measured work
+static volatile uint64_t benchSink;
+
+// Kept out of line so the compiler does not pair malloc/free across call sites
+#if defined(__GNUC__)
+    #define BENCH_NOINLINE __attribute__((noinline))
+#else
+    #define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw bad_alloc();
+}
+
+BENCH_NOINLINE void operator delete(void* p) noexcept { free(p); }
+BENCH_NOINLINE void operator delete(void* p, size_t) noexcept { free(p); }
+
+// ============================================
+// Benchmark Harness
+// ============================================
+
+struct BenchResult {
+    string name;
+    string mode;
+    int rows;
+    int cols;
+    size_t length;
+    uint64_t ops;
+    double seconds;
+    uint64_t allocations;
+};
+
+class BenchReporter {
+private:
+    bool json;
+    bool first = true;
+
+public:
+    explicit BenchReporter(bool jsonOutput) : json(jsonOutput) {
+        if (json) {
+            cout << "[\n";
+        } else {
+            cout << "bench,mode,rows,cols,length,ops,seconds,ns_per_op,ops_per_sec,allocs_per_op\n";
+        }
+    }
+
+    void report(const BenchResult& r) {
+        double nsPerOp = r.seconds * 1e9 / r.ops;
+        double opsPerSec = r.ops / r.seconds;
+        double allocsPerOp = static_cast<double>(r.allocations) / r.ops;
+
+        if (json) {
+            cout << (first ? "" : ",\n")
+                 << "  {\"bench\": \"" << r.name << "\", \"mode\": \"" << r.mode
+                 << "\", \"rows\": " << r.rows << ", \"cols\": " << r.cols
+                 << ", \"length\": " << r.length << ", \"ops\": " << r.ops
+                 << ", \"seconds\": " << r.seconds << ", \"ns_per_op\": " << nsPerOp
+                 << ", \"ops_per_sec\": " << opsPerSec << ", \"allocs_per_op\": " << allocsPerOp << "}";
+        } else {
+            cout << r.name << "," << r.mode << "," << r.rows << "," << r.cols << ","
+                 << r.length << "," << r.ops << "," << r.seconds << "," << nsPerOp << ","
+                 << opsPerSec << "," << allocsPerOp << "\n";
+        }
+        cout.flush();
+        first = false;
+    }
+
+    ~BenchReporter() {
+        if (json) cout << "\n]\n";
+    }
+};
+
+/**
+ * Runs `body(n)` with growing batch sizes until at least `minSeconds` of
+ * measured time has accumulated. `body` performs n operations and returns
+ * the seconds it spent on the part being measured.
+ */
+template<typename Body>
+BenchResult measure(const string& name, const string& mode, int rows, int cols, size_t length,
+                    double minSeconds, Body&& body) {
+    BenchResult result = {name, mode, rows, cols, length, 0, 0.0, 0};
+    uint64_t batch = 1;
+
+    while (result.seconds < minSeconds) {
+        uint64_t allocationsBefore = allocationCount.load(memory_order_relaxed);
+        result.seconds += body(batch);
+        result.allocations += allocationCount.load(memory_order_relaxed) - allocationsBefore;
+        result.ops += batch;
+        if (batch < (1u << 20)) batch *= 2;
+    }
+    return result;
+}
+
+template<typename Work>
+double timed(Work&& work) {
+    auto start = chrono::steady_clock::now();
+    work();
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+// ============================================
+// Workload Setup
+// ============================================
+
+/**
+ * Direction of a Hamiltonian cycle over an even-row board: serpentine over
+ * columns 1..cols-1, returning up column 0. A snake that follows it never
+ * collides, so games run for as long as the benchmark needs.
+ */
+static Direction cycleDirection(int r, int c, int rows, int cols) {
+    if (c == 0) return r == 0 ? RIGHT : UP;
+    if (r % 2 == 0) return c < cols - 1 ? RIGHT : DOWN;
+    if (c > 1) return LEFT;
+    return r == rows - 1 ? LEFT : DOWN;
+}
+
+/**
+ * Lays a snake of `length` cells along the cycle, head first.
+ */
+static vector<uint32_t> cycleBody(int rows, int cols, size_t length, Direction& heading) {
+    vector<uint32_t> order;
+    order.reserve(length);
+    int r = 0, c = 0;
+    for (size_t i = 0; i < length; i++) {
+        order.push_back(static_cast<uint32_t>(r * cols + c));
+        switch (cycleDirection(r, c, rows, cols)) {
+            case UP:    r--; break;
+            case DOWN:  r++; break;
+            case LEFT:  c--; break;
+            case RIGHT: c++; break;
+            case NONE:  break;
+        }
+    }
+    uint32_t head = order.back();
+    heading = cycleDirection(head / cols, head % cols, rows, cols);
+    return vector<uint32_t>(order.rbegin(), order.rend());
+}
+
+template<typename Game>
+static void steer(Game& game, int rows, int cols) {
+    pair<int, int> head = game.getSimulation().getSnake().getHead();
+    game.setDirection(cycleDirection(head.first, head.second, rows, cols));
+}
+
+// ============================================
+// Benchmarks
+// ============================================
+
+struct BenchSettings {
+    double minSeconds = 0.2;
+    int maxCells = 2048 * 2048;
+};
+
+/**
+ * Game defaults to the runtime-sized board; the "fixed" rows instantiate
+ * it over the compile-time board visitBoardType picks for the size.
+ */
+template<typename Game = SnakeGameLogic>
+static void benchUpdate(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                        size_t length, bool snapshots, const string& mode = "") {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Game game;
+    game.setKeyframeInterval(snapshots ? 1 : 0);
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+
+    out.report(measure("update", !mode.empty() ? mode : snapshots ? "snapshot" : "headless",
+                       rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                steer(game, rows, cols);
+                if (!game.update()) {
+                    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+                }
+            }
+        });
+    }));
+}
+
+template<typename RandomT = GameRandom>
+static void benchPlaceRandom(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                             size_t length, const string& mode = "mt19937") {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Board board;
+    board.initialize(rows, cols);
+    Snake snake;
+    snake.initializePath(body, board);
+    RandomT rng(42);
+    FoodManager food;
+
+    out.report(measure("placeRandom", mode, rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                food.placeRandom(board, rng);
+                food.remove(board);
+            }
+        });
+    }));
+}
+
+/**
+ * One engine on its own: raw draws, bounded draws, and rebuilding the
+ * state a million draws in (what loading a checkpoint does).
+ */
+template<typename RandomT>
+static void benchRandom(BenchReporter& out, const BenchSettings& settings, const string& mode) {
+    RandomT rng(42);
+    uint64_t sum = 0;
+    out.report(measure("rng", mode + "-draw", 0, 0, 0, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) sum += rng();
+        });
+    }));
+    out.report(measure("rng", mode + "-below", 0, 0, 0, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) sum += rng.below(1000003);
+        });
+    }));
+    out.report(measure("rng", mode + "-restore-1M", 0, 0, 0, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                rng.restore(static_cast<uint32_t>(i), 1000000);
+                sum += rng();
+            }
+        });
+    }));
+    benchSink = sum;
+}
+
+static void benchSelfCollision(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                               size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Board board;
+    board.initialize(rows, cols);
+    Snake snake;
+    snake.initializePath(body, board);
+
+    GameRandom rng(7);
+    vector<pair<int, int>> probes(4096);
+    for (auto& probe : probes) {
+        probe = {static_cast<int>(rng() % rows), static_cast<int>(rng() % cols)};
+    }
+
+    uint64_t hits = 0;
+    out.report(measure("checkSelfCollision", "-", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                hits += snake.checkSelfCollision(probes[i & 4095], board);
+            }
+        });
+    }));
+    benchSink = hits;
+}
+
+static void benchPublish(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                         size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Board board;
+    board.initialize(rows, cols);
+    Snake snake;
+    snake.initializePath(body, board);
+    GameRandom rng(42);
+    FoodManager food;
+    food.placeRandom(board, rng);
+    StatePublisher publisher;
+    uint64_t tick = 0;
+
+    out.report(measure("publish", "snapshot", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                publisher.publish(board, snake, food, 0, false, ++tick);
+            }
+        });
+    }));
+
+    out.report(measure("publish", "snapshot+pin", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                publisher.publish(board, snake, food, 0, false, ++tick);
+                benchSink = publisher.getState().tick;
+            }
+        });
+    }));
+
+    // Each op pins a frame and reads every cell through the game's accessor
+    SnakeGameLogic game;
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+    out.report(measure("getCellType", "board-scan", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            uint64_t snakeCells = 0;
+            for (uint64_t i = 0; i < n; i++) {
+                game.getGameState();
+                for (int r = 0; r < rows; r++) {
+                    for (int c = 0; c < cols; c++) snakeCells += game.getCellType(r, c) == SNAKE;
+                }
+            }
+            benchSink = snakeCells;
+        });
+    }));
+}
+
+/**
+ * Whole-board queries on the bit planes, each next to the byte-grid scan
+ * it replaces.
+ */
+static void benchOccupancy(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                           size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Board board;
+    board.initialize(rows, cols);
+    Snake snake;
+    snake.initializePath(body, board);
+    int head = static_cast<int>(body.front());
+
+    GameRandom rng(3);
+    uint64_t sum = 0;
+    out.report(measure("countFree", "bitboard", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) sum += board.getOccupancy(EMPTY).count();
+        });
+    }));
+    out.report(measure("countFree", "byte-scan", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                sum += count(board.getCells().begin(), board.getCells().end(), uint8_t(EMPTY));
+            }
+        });
+    }));
+    out.report(measure("selectFree", "bitboard", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                sum += board.selectFreeCell(static_cast<int>(rng() % board.getFreeCellCount()));
+            }
+        });
+    }));
+    out.report(measure("selectFree", "byte-scan", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                int k = static_cast<int>(rng() % board.getFreeCellCount());
+                int index = 0;
+                for (; board.getCell(index) != EMPTY || k-- > 0; index++) {}
+                sum += index;
+            }
+        });
+    }));
+
+    Board::BitPlaneType reached, passable;
+    out.report(measure("reachable", "bitboard", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) sum += board.countReachable(head, reached, passable);
+        });
+    }));
+    vector<int> queue(board.getCellCount());
+    vector<uint8_t> seen(board.getCellCount());
+    out.report(measure("reachable", "byte-bfs", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                fill(seen.begin(), seen.end(), uint8_t(0));
+                size_t readPos = 0, writePos = 0;
+                queue[writePos++] = head;
+                seen[head] = 1;
+                while (readPos < writePos) {
+                    int cell = queue[readPos++];
+                    int r = cell / cols, c = cell % cols;
+                    const int next[4] = {r > 0 ? cell - cols : -1, r < rows - 1 ? cell + cols : -1,
+                                         c > 0 ? cell - 1 : -1, c < cols - 1 ? cell + 1 : -1};
+                    for (int neighbor : next) {
+                        if (neighbor < 0 || seen[neighbor]) continue;
+                        int type = board.getCell(neighbor);
+                        if (type != EMPTY && type != FOOD) continue;
+                        seen[neighbor] = 1;
+                        queue[writePos++] = neighbor;
+                    }
+                }
+                sum += writePos - 1;
+            }
+        });
+    }));
+    benchSink = sum;
+}
+
+/**
+ * On a chunked board the renderer draws the published window (64x64, as
+ * the null sink has no terminal size) wherever the head is.
+ */
+template<typename Game = SnakeGameLogic>
+static void benchRender(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                        size_t length, const string& mode = "null-sink") {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    Game game;
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+
+    TerminalController terminal;
+    terminal.setDiscardOutput(true);
+    HighScoreManager highScores;
+    GameConfig config;
+    config.rows = rows;
+    config.cols = cols;
+    GameRenderer renderer(terminal, highScores, config);
+    renderer.updateGameBoard(game);
+
+    out.report(measure("updateGameBoard", mode, rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        double seconds = 0;
+        for (uint64_t i = 0; i < n; i++) {
+            steer(game, rows, cols);
+            if (!game.update()) {
+                game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+            }
+            seconds += timed([&] {
+                renderer.updateGameBoard(game);
+                renderer.requestViewport(game);
+            });
+        }
+        return seconds;
+    }));
+}
+
+static void benchAutopilot(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                           size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+
+    for (AutopilotMode mode : {AUTOPILOT_GREEDY, AUTOPILOT_HAMILTONIAN}) {
+        SnakeGameLogic game;
+        game.setKeyframeInterval(0);
+        game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+        Autopilot pilot(mode);
+        pilot.reserve(rows, cols);
+
+        out.report(measure("autopilot", mode == AUTOPILOT_GREEDY ? "greedy" : "hamiltonian", rows, cols,
+                           length, settings.minSeconds, [&](uint64_t n) {
+            double seconds = 0;
+            for (uint64_t i = 0; i < n; i++) {
+                Direction direction = NONE;
+                seconds += timed([&] { direction = pilot.decide(game.getSimulation()); });
+                if (direction != NONE) game.setDirection(direction);
+                if (!game.update()) {
+                    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+                }
+            }
+            return seconds;
+        }));
+    }
+}
+
+/**
+ * Encoding cost per frame type (mode carries the mean frame size), then
+ * one tick published to 256 spectators with the default keyframe interval.
+ * Spectator queues are drained outside the timed region.
+ */
+static void benchBroadcast(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                           size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    SnakeGameLogic game;
+    game.setKeyframeInterval(0);
+
+    auto advance = [&] {
+        steer(game, rows, cols);
+        if (!game.update()) {
+            game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+        }
+    };
+
+    for (bool keyframes : {false, true}) {
+        game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+        BroadcastEncoder encoder;
+        encoder.encodeKeyframe(game.getSimulation());
+        uint64_t frames = 0;
+        uint64_t bytes = 0;
+
+        BenchResult result = measure("broadcast", "", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+            double seconds = 0;
+            for (uint64_t i = 0; i < n; i++) {
+                advance();
+                BroadcastFramePtr frame;
+                seconds += timed([&] {
+                    frame = keyframes ? encoder.encodeKeyframe(game.getSimulation())
+                                      : encoder.encodeDelta(game.getLastDelta());
+                });
+                frames++;
+                bytes += frame->bytes.size();
+            }
+            return seconds;
+        });
+        result.mode = string(keyframes ? "keyframe" : "delta") + " " + to_string(bytes / frames) + "B";
+        out.report(result);
+    }
+
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+    BroadcastHub hub;
+    vector<shared_ptr<Spectator>> spectators;
+    for (int i = 0; i < 256; i++) spectators.push_back(hub.subscribe());
+    hub.publishStart(game.getSimulation());
+
+    out.report(measure("broadcast", "fanout=256", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        double seconds = 0;
+        BroadcastFramePtr frame;
+        for (uint64_t i = 0; i < n; i++) {
+            advance();
+            seconds += timed([&] { hub.publishTick(game.getSimulation(), game.getLastDelta()); });
+            for (auto& spectator : spectators) {
+                while (spectator->poll(frame)) {}
+            }
+        }
+        return seconds;
+    }));
+}
+
+/**
+ * Checkpoint save into a reused buffer (mode carries the checkpoint size)
+ * and restore from it into a live game.
+ */
+static void benchCheckpoint(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                            size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    SnakeSimulation game;
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+    vector<uint8_t> bytes;
+    Checkpoint::save(game, bytes);
+
+    BenchResult result = measure("checkpoint", "", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                Checkpoint::save(game, bytes);
+            }
+        });
+    });
+    result.mode = "save " + to_string(bytes.size()) + "B";
+    out.report(result);
+
+    CheckpointView view;
+    view.attach(bytes.data(), bytes.size());
+    SnakeSimulation restored;
+    view.restore(restored);
+    out.report(measure("checkpoint", "restore", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                benchSink = view.restore(restored);
+            }
+        });
+    }));
+}
+
+/**
+ * Search-state clone into a reset arena, and one child expansion (apply
+ * then undo), cycling through the four presses so some children die.
+ */
+static void benchSearch(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                        size_t length) {
+    Direction heading;
+    vector<uint32_t> body = cycleBody(rows, cols, length, heading);
+    SnakeSimulation game;
+    game.initializeWithBody(rows, cols, body, 10, heading, 12345);
+    ScratchArena arena;
+    SearchState* root = SearchState::fromSimulation(game, arena, 64);
+    ScratchArena cloneArena;
+
+    out.report(measure("search", "clone", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                cloneArena.reset();
+                benchSink = root->clone(cloneArena)->getLength();
+            }
+        });
+    }));
+
+    static constexpr Direction PRESSES[] = {UP, RIGHT, DOWN, LEFT};
+    out.report(measure("search", "apply+undo", rows, cols, length, settings.minSeconds, [&](uint64_t n) {
+        return timed([&] {
+            for (uint64_t i = 0; i < n; i++) {
+                benchSink = root->apply(PRESSES[i & 3]);
+                root->undo();
+            }
+        });
+    }));
+}
+
+/**
+ * Each op is one arena tick of `snakes` bots (reported as the length). Bots
+ * turn away from cells that are not free and turn at random now and then;
+ * steering and respawning happen outside the timed step, which runs
+ * serially and then on all workers.
+ */
+static void benchArena(BenchReporter& out, const BenchSettings& settings, int rows, int cols,
+                       int snakes) {
+    static constexpr Direction TURNS[4][2] = {{LEFT, RIGHT}, {LEFT, RIGHT}, {UP, DOWN}, {UP, DOWN}};
+    static constexpr int STEP_ROW[] = {-1, 1, 0, 0};
+    static constexpr int STEP_COL[] = {0, 0, -1, 1};
+
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    for (unsigned workers : {1u, hardware}) {
+        WorkStealingPool pool(workers);
+        SnakeArena arena;
+        SplitMix64 rng(99);
+        arena.initialize(rows, cols, snakes, snakes, 10, 4321);
+
+        auto isFree = [&](pair<int, int> head, Direction dir) {
+            int cell = arena.getBoard().getCellType(head.first + STEP_ROW[dir], head.second + STEP_COL[dir]);
+            return cell == EMPTY || cell == FOOD;
+        };
+        auto prepare = [&] {
+            while (arena.getAliveCount() < snakes) {
+                arena.addSnake(static_cast<int>(rng.below(static_cast<uint32_t>(rows))),
+                               static_cast<int>(rng.below(static_cast<uint32_t>(cols))), 4,
+                               static_cast<Direction>(rng.below(4)));
+            }
+            for (int id = 0; id < snakes; id++) {
+                Direction dir = arena.getDirection(id);
+                pair<int, int> head = arena.getSnake(id).getHead();
+                if (isFree(head, dir) && rng.below(16) != 0) continue;
+                Direction turn = TURNS[dir][rng.below(2)];
+                if (!isFree(head, turn)) turn = turn == TURNS[dir][0] ? TURNS[dir][1] : TURNS[dir][0];
+                arena.setDirection(id, turn);
+            }
+        };
+        prepare();                   // First use of each slot sizes its ring
+        arena.step();
+
+        out.report(measure("arena", "workers=" + to_string(workers), rows, cols,
+                           static_cast<size_t>(snakes), settings.minSeconds, [&](uint64_t n) {
+            double seconds = 0;
+            for (uint64_t i = 0; i < n; i++) {
+                prepare();
+                seconds += timed([&] { arena.step(workers > 1 ? &pool : nullptr); });
+            }
+            benchSink = arena.getTick();
+            return seconds;
+        }));
+        if (hardware == 1) break;
+    }
+}
+
+/**
+ * Each op is a sweep of 1024 random-turn episodes; comparing the one-worker
+ * row with the all-workers row shows how the pool scales.
+ */
+static void benchSweep(BenchReporter& out, const BenchSettings& settings, int rows, int cols) {
+    SweepConfig config;
+    config.rows = rows;
+    config.cols = cols;
+    config.episodes = 1024;
+
+    unsigned hardware = max(1u, thread::hardware_concurrency());
+    for (unsigned workers : {1u, hardware}) {
+        WorkStealingPool pool(workers);
+        SimulationRunner<> runner(pool, config);
+        runner.run(RandomTurnPolicy{});
+
+        out.report(measure("sweep", "workers=" + to_string(workers), rows, cols,
+                           static_cast<size_t>(config.startingLength), settings.minSeconds, [&](uint64_t n) {
+            return timed([&] {
+                for (uint64_t i = 0; i < n; i++) {
+                    benchSink = runner.run(RandomTurnPolicy{}).totalScore;
+                }
+            });
+        }));
+        if (hardware == 1) break;
+    }
+}
+
+// ============================================
+// Main Entry Point
+// ============================================
+
+int main(int argc, char* argv[]) {
+    BenchSettings settings;
+    bool json = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else if (arg == "--csv") {
+            json = false;
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            settings.minSeconds = stod(argv[++i]);
+        } else if (arg == "--quick") {
+            settings.minSeconds = 0.05;
+            settings.maxCells = 512 * 512;
+        } else {
+            cerr << "Usage: " << argv[0] << " [--csv | --json] [--min-time SECONDS] [--quick]\n";
+            return 1;
+        }
+    }
+
+    const pair<int, int> sizes[] = {{20, 40}, {64, 64}, {256, 256}, {512, 512}, {1024, 1024}, {2048, 2048}};
+    BenchReporter out(json);
+
+    benchRandom<GameRandom>(out, settings, "mt19937");
+    benchRandom<Pcg32Random>(out, settings, "pcg32");
+    benchRandom<Xoshiro256Random>(out, settings, "xoshiro256");
+    benchRandom<PhiloxRandom>(out, settings, "philox");
+
+    for (auto [rows, cols] : sizes) {
+        size_t cells = static_cast<size_t>(rows) * cols;
+        if (cells > static_cast<size_t>(settings.maxCells)) continue;
+
+        for (size_t length : {size_t(3), cells / 10, cells / 2}) {
+            benchUpdate(out, settings, rows, cols, length, true);
+            benchUpdate(out, settings, rows, cols, length, false);
+            visitBoardType(rows, cols, [&](auto board) {
+                using BoardT = typename decltype(board)::type;
+                if constexpr (BoardT::IS_FIXED) {
+                    benchUpdate<BasicSnakeGameLogic<BoardT>>(out, settings, rows, cols, length,
+                                                             false, "headless-fixed");
+                }
+            });
+            benchPlaceRandom(out, settings, rows, cols, length);
+            benchPlaceRandom<Pcg32Random>(out, settings, rows, cols, length, "pcg32");
+            benchSelfCollision(out, settings, rows, cols, length);
+            benchPublish(out, settings, rows, cols, length);
+            benchOccupancy(out, settings, rows, cols, length);
+            benchRender(out, settings, rows, cols, length);
+            benchAutopilot(out, settings, rows, cols, length);
+            benchBroadcast(out, settings, rows, cols, length);
+            benchCheckpoint(out, settings, rows, cols, length);
+            benchSearch(out, settings, rows, cols, length);
+        }
+        if (cells <= 64 * 64) benchSweep(out, settings, rows, cols);
+        if (cells >= 256 * 256) benchArena(out, settings, rows, cols, 500);
+    }
+
+    // A chunked board only holds the tiles the snake covers, so the huge
+    // board runs whatever the size limit
+    using ChunkedGame = BasicSnakeGameLogic<ChunkedBoard>;
+    const int hugeSize = 40000;
+    for (size_t length : {size_t(3), size_t(100000)}) {
+        benchUpdate<ChunkedGame>(out, settings, hugeSize, hugeSize, length, true, "snapshot-chunked");
+        benchUpdate<ChunkedGame>(out, settings, hugeSize, hugeSize, length, false, "headless-chunked");
+        benchRender<ChunkedGame>(out, settings, hugeSize, hugeSize, length, "viewport-chunked");
+    }
+    return 0;
+}
@@ -0,0 +1,361 @@
+// bitboard.h
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__BMI2__)
+    #include <immintrin.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// BIT PLANES
+// ============================================================================
+//
+// A bit plane holds one bit per board cell. Each row starts on a 64-bit word
+// boundary (the tail of the last word in a row is padding and always 0), so:
+//   - moving one row up or down is a word offset, with no bit shifting
+//   - moving one column left or right is a shift inside the row's words
+//   - counting, combining and filling work on 64 cells per instruction
+//
+// Kernels use POPCNT / BMI2 / AVX2 when the compiler targets them
+// (-mpopcnt, -mbmi2, -mavx2, or -march=native) and portable scalar code
+// otherwise.
+
+/**
+ * @brief One bit per cell, row-padded to whole 64-bit words.
+ *
+ * Cells are addressed by packed row-major index (row * cols + col), the
+ * same as `BasicBoard`. `BasicBitPlane<0, 0>` is sized at runtime;
+ * nonzero `Rows, Cols` give inline storage and constant strides.
+ */
+template<int Rows, int Cols>
+class BasicBitPlane {
+    static_assert((Rows > 0) == (Cols > 0), "Fix both dimensions or neither");
+
+public:
+    static constexpr bool IS_FIXED = Rows > 0;
+    static constexpr int WORDS_PER_ROW = (Cols + 63) / 64;
+    static constexpr size_t WORD_COUNT = static_cast<size_t>(Rows) * WORDS_PER_ROW;
+
+private:
+    using Storage = conditional_t<IS_FIXED, array<uint64_t, WORD_COUNT>, vector<uint64_t>>;
+
+    Storage words;
+    int rows;
+    int cols;
+    int wordsPerRow;
+
+    /**
+     * @brief Fills every run of `mask` that holds a bit of `seed`, toward higher bits.
+     *
+     * Kogge-Stone occluded fill: six shift/and/or steps cover a whole word.
+     */
+    static uint64_t fillUp(uint64_t seed, uint64_t mask) {
+        seed |= mask & (seed << 1);  mask &= mask << 1;
+        seed |= mask & (seed << 2);  mask &= mask << 2;
+        seed |= mask & (seed << 4);  mask &= mask << 4;
+        seed |= mask & (seed << 8);  mask &= mask << 8;
+        seed |= mask & (seed << 16); mask &= mask << 16;
+        seed |= mask & (seed << 32);
+        return seed;
+    }
+
+    /**
+     * @brief Mirror of fillUp(), toward lower bits.
+     */
+    static uint64_t fillDown(uint64_t seed, uint64_t mask) {
+        seed |= mask & (seed >> 1);  mask &= mask >> 1;
+        seed |= mask & (seed >> 2);  mask &= mask >> 2;
+        seed |= mask & (seed >> 4);  mask &= mask >> 4;
+        seed |= mask & (seed >> 8);  mask &= mask >> 8;
+        seed |= mask & (seed >> 16); mask &= mask >> 16;
+        seed |= mask & (seed >> 32);
+        return seed;
+    }
+
+    /**
+     * @brief Spreads `row` along the runs of `mask` in both directions.
+     *
+     * Carries cross word boundaries inside the row; padding bits are never
+     * in a mask, so nothing leaks into the next row.
+     */
+    static void fillRow(uint64_t* row, const uint64_t* mask, int count) {
+        uint64_t carry = 0;
+        for (int w = 0; w < count; w++) {
+            uint64_t v = fillUp(row[w] | (carry & mask[w]), mask[w]);
+            carry = v >> 63;
+            row[w] = v;
+        }
+        carry = 0;
+        for (int w = count - 1; w >= 0; w--) {
+            uint64_t v = fillDown(row[w] | ((carry << 63) & mask[w]), mask[w]);
+            carry = v & 1;
+            row[w] = v;
+        }
+    }
+
+    /**
+     * @brief row |= from & mask over one row of words.
+     * @return Nonzero if any bit was added
+     */
+    static uint64_t spreadInto(uint64_t* row, const uint64_t* from, const uint64_t* mask, int count) {
+        int w = 0;
+        uint64_t added = 0;
+#if defined(__AVX2__)
+        __m256i gained = _mm256_setzero_si256();
+        for (; w + 4 <= count; w += 4) {
+            __m256i r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row + w));
+            __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(from + w));
+            __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(mask + w));
+            __m256i incoming = _mm256_and_si256(f, m);
+            gained = _mm256_or_si256(gained, _mm256_andnot_si256(r, incoming));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + w), _mm256_or_si256(r, incoming));
+        }
+        added = !_mm256_testz_si256(gained, gained);
+#endif
+        for (; w < count; w++) {
+            uint64_t incoming = from[w] & mask[w];
+            added |= incoming & ~row[w];
+            row[w] |= incoming;
+        }
+        return added;
+    }
+
+    /**
+     * @brief Index of the k-th (0-based) set bit of a word; k < popcount(word).
+     */
+    static int selectInWord(uint64_t word, int k) {
+#if defined(__BMI2__)
+        return countr_zero(_pdep_u64(uint64_t(1) << k, word));
+#else
+        for (int i = 0; i < k; i++) {
+            word &= word - 1;
+        }
+        return countr_zero(word);
+#endif
+    }
+
+    static uint64_t popcountWords(const uint64_t* data, size_t count) {
+        const uint64_t* end = data + count;
+        uint64_t total = 0;
+#if defined(__AVX2__)
+        // Nibble-table popcount, summed per 64-bit lane with SAD (Mula et al.)
+        const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                               0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low = _mm256_set1_epi8(0x0f);
+        __m256i sums = _mm256_setzero_si256();
+        for (; end - data >= 4; data += 4) {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+            __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(v, low));
+            __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            sums = _mm256_add_epi64(sums, _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256()));
+        }
+        total = static_cast<uint64_t>(_mm256_extract_epi64(sums, 0)) + _mm256_extract_epi64(sums, 1) +
+                _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+#endif
+        for (; data != end; data++) {
+            total += popcount(*data);
+        }
+        return total;
+    }
+
+public:
+    BasicBitPlane() : rows(Rows), cols(Cols), wordsPerRow(WORDS_PER_ROW) {
+        if constexpr (IS_FIXED) words.fill(0);
+    }
+
+    /**
+     * @brief Sizes the plane (runtime planes only) and clears every bit.
+     */
+    void initialize(int rows, int cols) {
+        if constexpr (!IS_FIXED) {
+            this->rows = rows;
+            this->cols = cols;
+            wordsPerRow = (cols + 63) / 64;
+            words.assign(static_cast<size_t>(rows) * wordsPerRow, 0);
+        } else {
+            words.fill(0);
+        }
+    }
+
+    int getRows() const {
+        if constexpr (IS_FIXED) return Rows;
+        else return rows;
+    }
+
+    int getCols() const {
+        if constexpr (IS_FIXED) return Cols;
+        else return cols;
+    }
+
+    int getWordsPerRow() const {
+        if constexpr (IS_FIXED) return WORDS_PER_ROW;
+        else return wordsPerRow;
+    }
+
+    size_t getWordCount() const { return words.size(); }
+    const uint64_t* data() const { return words.data(); }
+    const uint64_t* row(int r) const { return words.data() + static_cast<size_t>(r) * getWordsPerRow(); }
+    uint64_t* row(int r) { return words.data() + static_cast<size_t>(r) * getWordsPerRow(); }
+
+    /**
+     * @brief Sets every bit that lies on the board (padding stays 0).
+     */
+    void fillAll() {
+        int fullWords = getCols() / 64;
+        int tailBits = getCols() % 64;
+        for (int r = 0; r < getRows(); r++) {
+            uint64_t* bits = row(r);
+            for (int w = 0; w < fullWords; w++) bits[w] = ~uint64_t(0);
+            if (tailBits) bits[fullWords] = (uint64_t(1) << tailBits) - 1;
+        }
+    }
+
+    void clear() {
+        fill(words.begin(), words.end(), uint64_t(0));
+    }
+
+    bool test(int index) const {
+        int r = index / getCols();
+        int c = index - r * getCols();
+        return (row(r)[c >> 6] >> (c & 63)) & 1;
+    }
+
+    void set(int index) {
+        int r = index / getCols();
+        set(r, index - r * getCols());
+    }
+
+    void reset(int index) {
+        int r = index / getCols();
+        reset(r, index - r * getCols());
+    }
+
+    void set(int r, int c) { row(r)[c >> 6] |= uint64_t(1) << (c & 63); }
+    void reset(int r, int c) { row(r)[c >> 6] &= ~(uint64_t(1) << (c & 63)); }
+
+    // ------------------------------------------------------------------
+    // Whole-plane queries
+    // ------------------------------------------------------------------
+
+    /**
+     * @brief Number of set bits.
+     */
+    int count() const {
+        return static_cast<int>(popcountWords(words.data(), words.size()));
+    }
+
+    /**
+     * @brief Finds the k-th set cell in row-major order.
+     * @param k 0-based rank
+     * @return Packed cell index, or -1 if fewer than k + 1 bits are set
+     */
+    int select(int k) const {
+        for (size_t w = 0; w < words.size(); w++) {
+            int bits = popcount(words[w]);
+            if (k < bits) {
+                int r = static_cast<int>(w / getWordsPerRow());
+                int c = static_cast<int>(w % getWordsPerRow()) * 64 + selectInWord(words[w], k);
+                return r * getCols() + c;
+            }
+            k -= bits;
+        }
+        return -1;
+    }
+
+    /**
+     * @brief Calls `visit(index)` for every set cell in row-major order.
+     */
+    template<typename Visit>
+    void forEach(Visit&& visit) const {
+        for (size_t w = 0; w < words.size(); w++) {
+            int rowBase = static_cast<int>(w / getWordsPerRow()) * getCols();
+            int colBase = static_cast<int>(w % getWordsPerRow()) * 64;
+            for (uint64_t bits = words[w]; bits; bits &= bits - 1) {
+                visit(rowBase + colBase + countr_zero(bits));
+            }
+        }
+    }
+
+    /**
+     * @brief this = a | b (planes of the same size).
+     */
+    void assignOr(const BasicBitPlane& a, const BasicBitPlane& b) {
+        if constexpr (!IS_FIXED) {
+            rows = a.rows;
+            cols = a.cols;
+            wordsPerRow = a.wordsPerRow;
+            words.resize(a.words.size());
+        }
+        for (size_t w = 0; w < words.size(); w++) {
+            words[w] = a.words[w] | b.words[w];
+        }
+    }
+
+    /**
+     * @brief Flood-fills from one cell through a passable plane (4-connected).
+     *
+     * The seed is always reached, passable or not; every other reached cell
+     * is passable. Works row at a time: each sweep pulls bits down (then up)
+     * from the neighboring row and spreads them along the row's passable
+     * runs, and sweeps repeat until nothing changes. Open areas settle in a
+     * couple of sweeps; every reversal of a winding corridor costs one more.
+     * @param seed Packed cell index to start from
+     * @param passable Cells the fill may enter (same size as this plane)
+     * @return Number of reached cells
+     */
+    int floodFill(int seed, const BasicBitPlane& passable) {
+        if constexpr (!IS_FIXED) {
+            initialize(passable.rows, passable.cols);
+        } else {
+            clear();
+        }
+        set(seed);
+
+        const int height = getRows();
+        const int width = getWordsPerRow();
+        const int seedRow = seed / getCols();
+        fillRow(row(seedRow), passable.row(seedRow), width);
+
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (int r = 1; r < height; r++) {
+                changed |= spreadRow(r, r - 1, passable, width);
+            }
+            for (int r = height - 2; r >= 0; r--) {
+                changed |= spreadRow(r, r + 1, passable, width);
+            }
+        }
+        return count();
+    }
+
+private:
+    /**
+     * @brief Pulls reached cells from row `from` into row `r` and spreads them.
+     *
+     * Rows are kept spread along their runs after every change, so a row
+     * that gains nothing from its neighbor needs no fill.
+     * @return Whether row `r` gained any cell
+     */
+    bool spreadRow(int r, int from, const BasicBitPlane& passable, int width) {
+        uint64_t* bits = row(r);
+        const uint64_t* mask = passable.row(r);
+        if (!spreadInto(bits, row(from), mask, width)) return false;
+        fillRow(bits, mask, width);
+        return true;
+    }
+};
+
+/// Bit plane sized at runtime
+using BitPlane = BasicBitPlane<0, 0>;
+
+#endif // BITBOARD_H
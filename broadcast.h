@@ -0,0 +1,526 @@
+// broadcast.h
+#ifndef BROADCAST_H
+#define BROADCAST_H
+
+#include "gameLogic.h"
+#include <mutex>
+
+// ============================================================================
+// WIRE FORMAT
+// ============================================================================
+//
+// Every frame starts with a type byte. Integers are LEB128 varints; signed
+// values are zigzag-coded first.
+//
+// Keyframe ('K'): tick, rows, cols, score (signed), flags (bit 0 game over,
+//   bit 1 food present), food cell (if present), snake length, head cell
+//   (if length > 0), the body as 2-bit directions from each segment to the
+//   next (four per byte), then the board run-length encoded as
+//   (cell type byte, run length) pairs covering rows * cols cells.
+//
+// Delta ('D'): tick advance, field mask (DELTA_* bits), then for each
+//   present field in mask order: head as an offset from the previous head,
+//   tail as an offset from the previous tail, food eaten as an offset from
+//   the new head (0 on a normal meal), new food cell, score gained (signed).
+//   A straight move costs five bytes.
+
+enum BroadcastFrameType : uint8_t {
+    FRAME_KEYFRAME = 'K',
+    FRAME_DELTA = 'D'
+};
+
+enum BroadcastDeltaField : uint8_t {
+    DELTA_HEAD = 1 << 0,
+    DELTA_TAIL = 1 << 1,
+    DELTA_FOOD_REMOVED = 1 << 2,
+    DELTA_FOOD_ADDED = 1 << 3,
+    DELTA_SCORE = 1 << 4,
+    DELTA_GAME_OVER = 1 << 5
+};
+
+/**
+ * @brief One encoded tick, shared read-only by every spectator queue.
+ */
+struct BroadcastFrame {
+    uint64_t tick;
+    bool keyframe;
+    vector<uint8_t> bytes;
+};
+
+using BroadcastFramePtr = shared_ptr<const BroadcastFrame>;
+
+/**
+ * @brief LEB128 varint and zigzag helpers.
+ */
+class VarintCodec {
+public:
+    static void put(vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    static void putSigned(vector<uint8_t>& out, int64_t value) {
+        put(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    /// Reads a varint, advancing `p`; false on truncated or oversized input
+    static bool get(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64 && p < end; shift += 7) {
+            uint8_t byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    static bool getSigned(const uint8_t*& p, const uint8_t* end, int64_t& value) {
+        uint64_t raw;
+        if (!get(p, end, raw)) return false;
+        value = static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+        return true;
+    }
+};
+
+// ============================================================================
+// ENCODER / DECODER
+// ============================================================================
+
+/**
+ * @brief Turns ticks into frames, once per tick regardless of audience size.
+ *
+ * Deltas predict the head and tail from the previous frame, so the encoder
+ * and every decoder track the same two cells; a keyframe resets them.
+ */
+class BroadcastEncoder {
+private:
+    int32_t lastHead;
+    int32_t lastTail;
+    uint64_t lastTick;
+    int cols;
+
+    static uint8_t directionCode(int32_t from, int32_t to, int cols) {
+        if (to == from - cols) return UP;
+        if (to == from + cols) return DOWN;
+        if (to == from - 1) return LEFT;
+        return RIGHT;
+    }
+
+public:
+    BroadcastEncoder() : lastHead(-1), lastTail(-1), lastTick(0), cols(0) {}
+
+    /**
+     * @brief Full state after the simulation's latest tick.
+     * @param game A BasicSnakeSimulation over a dense board
+     */
+    template<typename Simulation>
+    BroadcastFramePtr encodeKeyframe(const Simulation& game) {
+        static_assert(!Simulation::BoardType::IS_SPARSE,
+                      "Keyframes run-length encode the board's byte grid, which a sparse board does not have");
+        const auto& board = game.getBoard();
+        const Snake& snake = game.getSnake();
+        const FoodManager& food = game.getFoodManager();
+        cols = board.getCols();
+
+        auto frame = make_shared<BroadcastFrame>();
+        frame->tick = game.getTick();
+        frame->keyframe = true;
+        vector<uint8_t>& out = frame->bytes;
+        out.push_back(FRAME_KEYFRAME);
+        VarintCodec::put(out, game.getTick());
+        VarintCodec::put(out, static_cast<uint64_t>(board.getRows()));
+        VarintCodec::put(out, static_cast<uint64_t>(cols));
+        VarintCodec::putSigned(out, game.getScore());
+        out.push_back(static_cast<uint8_t>((game.isGameOver() ? 1 : 0) | (food.isPresent() ? 2 : 0)));
+        if (food.isPresent()) {
+            VarintCodec::put(out, static_cast<uint64_t>(board.toIndex(food.getPosition().first,
+                                                                      food.getPosition().second)));
+        }
+
+        SnakeBodyView body = snake.getBody();
+        VarintCodec::put(out, body.size());
+        if (body.size() > 0) {
+            VarintCodec::put(out, body[0]);
+            uint8_t packed = 0;
+            for (size_t i = 1; i < body.size(); i++) {
+                uint8_t code = directionCode(static_cast<int32_t>(body[i - 1]), static_cast<int32_t>(body[i]), cols);
+                packed |= static_cast<uint8_t>(code << (((i - 1) & 3) * 2));
+                if ((i & 3) == 0 || i + 1 == body.size()) {
+                    out.push_back(packed);
+                    packed = 0;
+                }
+            }
+        }
+
+        span<const uint8_t> cells = board.getCells();
+        for (size_t i = 0; i < cells.size();) {
+            size_t run = 1;
+            while (i + run < cells.size() && cells[i + run] == cells[i]) run++;
+            out.push_back(cells[i]);
+            VarintCodec::put(out, run);
+            i += run;
+        }
+
+        lastHead = body.size() > 0 ? static_cast<int32_t>(body[0]) : -1;
+        lastTail = body.size() > 0 ? static_cast<int32_t>(body[body.size() - 1]) : -1;
+        lastTick = game.getTick();
+        return frame;
+    }
+
+    /**
+     * @brief One tick's changes; must follow a keyframe of the same game.
+     */
+    BroadcastFramePtr encodeDelta(const GameDelta& delta) {
+        auto frame = make_shared<BroadcastFrame>();
+        frame->tick = delta.tick;
+        frame->keyframe = false;
+        vector<uint8_t>& out = frame->bytes;
+        out.reserve(8);
+
+        uint8_t mask = (delta.headAdded >= 0 ? DELTA_HEAD : 0) |
+                       (delta.tailRemoved >= 0 ? DELTA_TAIL : 0) |
+                       (delta.foodRemoved >= 0 ? DELTA_FOOD_REMOVED : 0) |
+                       (delta.foodAdded >= 0 ? DELTA_FOOD_ADDED : 0) |
+                       (delta.scoreDelta != 0 ? DELTA_SCORE : 0) |
+                       (delta.gameOver ? DELTA_GAME_OVER : 0);
+        out.push_back(FRAME_DELTA);
+        VarintCodec::put(out, delta.tick - lastTick);
+        out.push_back(mask);
+
+        int32_t head = delta.headAdded >= 0 ? delta.headAdded : lastHead;
+        if (mask & DELTA_HEAD) VarintCodec::putSigned(out, delta.headAdded - lastHead);
+        if (mask & DELTA_TAIL) VarintCodec::putSigned(out, delta.tailRemoved - lastTail);
+        if (mask & DELTA_FOOD_REMOVED) VarintCodec::putSigned(out, delta.foodRemoved - head);
+        if (mask & DELTA_FOOD_ADDED) VarintCodec::put(out, static_cast<uint64_t>(delta.foodAdded));
+        if (mask & DELTA_SCORE) VarintCodec::putSigned(out, delta.scoreDelta);
+
+        lastHead = head;
+        if (delta.tailRemoved >= 0) lastTail = delta.tailRemoved;
+        lastTick = delta.tick;
+        return frame;
+    }
+};
+
+/**
+ * @brief Rebuilds a GameState from a frame stream.
+ *
+ * Deltas are ignored until the first keyframe. The ordered `snake` body is
+ * refreshed by keyframes only, as with GameState::applyDelta().
+ */
+class BroadcastDecoder {
+private:
+    GameState state;
+    bool synced;
+    int32_t lastTail;
+
+    bool decodeKeyframe(const uint8_t* p, const uint8_t* end) {
+        uint64_t tick, rows, cols, length, value;
+        int64_t score;
+        if (!VarintCodec::get(p, end, tick) || !VarintCodec::get(p, end, rows) ||
+            !VarintCodec::get(p, end, cols) || !VarintCodec::getSigned(p, end, score) || p >= end) {
+            return false;
+        }
+        if (rows == 0 || cols == 0 || rows * cols > (uint64_t(1) << 30)) return false;
+        uint8_t flags = *p++;
+        size_t cellCount = static_cast<size_t>(rows * cols);
+
+        state.rows = static_cast<int>(rows);
+        state.cols = static_cast<int>(cols);
+        state.stride = state.cols;
+        state.originRow = 0;
+        state.originCol = 0;
+        state.boardRows = state.rows;
+        state.boardCols = state.cols;
+        state.score = static_cast<int>(score);
+        state.gameOver = (flags & 1) != 0;
+        state.foodExists = (flags & 2) != 0;
+        state.food = {-1, -1};
+        state.tick = tick;
+        if (state.foodExists) {
+            if (!VarintCodec::get(p, end, value) || value >= cellCount) return false;
+            state.food = {static_cast<int>(value / cols), static_cast<int>(value % cols)};
+        }
+
+        if (!VarintCodec::get(p, end, length) || length > cellCount) return false;
+        state.snake.resize(length);
+        state.snakeLength = static_cast<int>(length);
+        state.snakeHead = -1;
+        if (length > 0) {
+            if (!VarintCodec::get(p, end, value) || value >= cellCount) return false;
+            state.snake[0] = static_cast<uint32_t>(value);
+            state.snakeHead = static_cast<int32_t>(value);
+            int64_t offsets[4] = {-static_cast<int64_t>(cols), static_cast<int64_t>(cols), -1, 1};
+            for (size_t i = 1; i < length; i++) {
+                if (((i - 1) & 3) == 0 && p >= end) return false;
+                uint8_t code = (p[0] >> (((i - 1) & 3) * 2)) & 3;
+                if ((i & 3) == 0 || i + 1 == length) p++;
+                int64_t cell = static_cast<int64_t>(state.snake[i - 1]) + offsets[code];
+                if (cell < 0 || cell >= static_cast<int64_t>(cellCount)) return false;
+                state.snake[i] = static_cast<uint32_t>(cell);
+            }
+        }
+
+        state.board.resize(cellCount);
+        for (size_t i = 0; i < cellCount;) {
+            if (p >= end) return false;
+            uint8_t cell = *p++;
+            uint64_t run;
+            if (!VarintCodec::get(p, end, run) || run == 0 || run > cellCount - i) return false;
+            fill_n(state.board.begin() + static_cast<ptrdiff_t>(i), run, cell);
+            i += static_cast<size_t>(run);
+        }
+
+        lastTail = length > 0 ? static_cast<int32_t>(state.snake[length - 1]) : -1;
+        synced = true;
+        return true;
+    }
+
+    bool decodeDelta(const uint8_t* p, const uint8_t* end) {
+        uint64_t advance, value;
+        if (!VarintCodec::get(p, end, advance) || p >= end) return false;
+        uint8_t mask = *p++;
+        int64_t offset;
+        int64_t cellCount = static_cast<int64_t>(state.board.size());
+
+        GameDelta delta = {state.tick + advance, -1, -1, -1, -1, 0, (mask & DELTA_GAME_OVER) != 0};
+        int64_t head = state.snakeHead;
+        if (mask & DELTA_HEAD) {
+            if (!VarintCodec::getSigned(p, end, offset)) return false;
+            head += offset;
+            if (head < 0 || head >= cellCount) return false;
+            delta.headAdded = static_cast<int32_t>(head);
+        }
+        if (mask & DELTA_TAIL) {
+            if (!VarintCodec::getSigned(p, end, offset)) return false;
+            int64_t tail = lastTail + offset;
+            if (tail < 0 || tail >= cellCount) return false;
+            delta.tailRemoved = static_cast<int32_t>(tail);
+        }
+        if (mask & DELTA_FOOD_REMOVED) {
+            if (!VarintCodec::getSigned(p, end, offset)) return false;
+            int64_t eaten = head + offset;
+            if (eaten < 0 || eaten >= cellCount) return false;
+            delta.foodRemoved = static_cast<int32_t>(eaten);
+        }
+        if (mask & DELTA_FOOD_ADDED) {
+            if (!VarintCodec::get(p, end, value) || static_cast<int64_t>(value) >= cellCount) return false;
+            delta.foodAdded = static_cast<int32_t>(value);
+        }
+        if (mask & DELTA_SCORE) {
+            if (!VarintCodec::getSigned(p, end, offset)) return false;
+            delta.scoreDelta = static_cast<int32_t>(offset);
+        }
+
+        // The tail leaves before the head arrives, as in Snake::move()
+        state.applyDelta(delta);
+        if (delta.tailRemoved >= 0) lastTail = delta.tailRemoved;
+        return true;
+    }
+
+public:
+    BroadcastDecoder() : state{}, synced(false), lastTail(-1) {}
+
+    /**
+     * @brief Applies one frame.
+     * @return False for a malformed frame; the decoder then waits for the next keyframe
+     */
+    bool apply(const uint8_t* data, size_t size) {
+        if (size == 0) return false;
+        const uint8_t* end = data + size;
+        bool ok = true;
+        if (data[0] == FRAME_KEYFRAME) {
+            ok = decodeKeyframe(data + 1, end);
+        } else if (data[0] == FRAME_DELTA) {
+            if (!synced) return true;
+            ok = decodeDelta(data + 1, end);
+        } else {
+            ok = false;
+        }
+        if (!ok) synced = false;
+        return ok;
+    }
+
+    bool apply(const BroadcastFrame& frame) {
+        return apply(frame.bytes.data(), frame.bytes.size());
+    }
+
+    bool isSynced() const { return synced; }
+    const GameState& getState() const { return state; }
+};
+
+// ============================================================================
+// FAN-OUT
+// ============================================================================
+
+/**
+ * @brief One viewer's queue: a single-producer, single-consumer ring of frames.
+ *
+ * The hub pushes and the viewer polls, each from its own thread. Frames are
+ * shared pointers into the hub's encoding, so a queued frame costs one
+ * pointer and a reference count.
+ */
+class Spectator {
+private:
+    friend class BroadcastHub;
+
+    vector<BroadcastFramePtr> slots;
+    size_t mask;
+    alignas(64) atomic<uint64_t> writeIndex;
+    alignas(64) atomic<uint64_t> readIndex;
+    atomic<uint64_t> framesDropped;
+    atomic<bool> closed;
+    bool lagging;        // Hub only: skipping deltas until a keyframe fits
+
+    bool tryPush(const BroadcastFramePtr& frame) {
+        uint64_t write = writeIndex.load(memory_order_relaxed);
+        if (write - readIndex.load(memory_order_acquire) >= slots.size()) return false;
+        slots[write & mask] = frame;
+        writeIndex.store(write + 1, memory_order_release);
+        return true;
+    }
+
+public:
+    explicit Spectator(size_t capacity)
+        : mask(0), writeIndex(0), readIndex(0), framesDropped(0), closed(false), lagging(false) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    Spectator(const Spectator&) = delete;
+    Spectator& operator=(const Spectator&) = delete;
+
+    /**
+     * @brief Takes the next frame (viewer thread).
+     * @return False if nothing is queued
+     */
+    bool poll(BroadcastFramePtr& frame) {
+        uint64_t read = readIndex.load(memory_order_relaxed);
+        if (read == writeIndex.load(memory_order_acquire)) return false;
+        frame = std::move(slots[read & mask]);
+        readIndex.store(read + 1, memory_order_release);
+        return true;
+    }
+
+    size_t pending() const {
+        return static_cast<size_t>(writeIndex.load(memory_order_acquire) - readIndex.load(memory_order_acquire));
+    }
+
+    /// Frames skipped because this viewer fell behind
+    uint64_t getFramesDropped() const { return framesDropped.load(memory_order_relaxed); }
+
+    /// Leaves the broadcast; the hub forgets the queue on its next publish
+    void close() { closed.store(true, memory_order_release); }
+    bool isClosed() const { return closed.load(memory_order_acquire); }
+};
+
+struct BroadcastConfig {
+    int keyframeInterval = 64;       ///< Ticks between keyframes (>= 1)
+    size_t queueCapacity = 256;      ///< Frames a viewer may fall behind before it is skipped ahead
+};
+
+/**
+ * @brief Encodes one game's ticks once and fans the frames out to every viewer.
+ *
+ * The producer never waits for viewers: a viewer whose queue is full stops
+ * receiving deltas and resumes at the next keyframe that fits, so it skips
+ * ahead instead of holding anything up. Frames since the last keyframe are
+ * kept so a new viewer is in sync from its first poll. The spectator list
+ * is guarded by a mutex that only subscribe() and publishing take.
+ */
+class BroadcastHub {
+private:
+    BroadcastConfig config;
+    BroadcastEncoder encoder;
+    mutex spectatorsMutex;
+    vector<shared_ptr<Spectator>> spectators;
+    vector<BroadcastFramePtr> sinceKeyframe;
+    int ticksSinceKeyframe;
+    uint64_t framesEncoded;
+    uint64_t bytesEncoded;
+
+    void fanOut(const BroadcastFramePtr& frame) {
+        framesEncoded++;
+        bytesEncoded += frame->bytes.size();
+
+        lock_guard<mutex> lock(spectatorsMutex);
+        if (frame->keyframe) sinceKeyframe.clear();
+        sinceKeyframe.push_back(frame);
+
+        size_t kept = 0;
+        for (size_t i = 0; i < spectators.size(); i++) {
+            Spectator& spectator = *spectators[i];
+            if (spectator.isClosed()) continue;
+            spectators[kept++] = spectators[i];
+
+            if (spectator.lagging && !frame->keyframe) {
+                spectator.framesDropped.fetch_add(1, memory_order_relaxed);
+            } else if (spectator.tryPush(frame)) {
+                spectator.lagging = false;
+            } else {
+                spectator.lagging = true;
+                spectator.framesDropped.fetch_add(1, memory_order_relaxed);
+            }
+        }
+        spectators.resize(kept);
+    }
+
+public:
+    explicit BroadcastHub(const BroadcastConfig& broadcastConfig = BroadcastConfig())
+        : config(broadcastConfig), ticksSinceKeyframe(0), framesEncoded(0), bytesEncoded(0) {
+        config.keyframeInterval = max(config.keyframeInterval, 1);
+        config.queueCapacity = max(config.queueCapacity, static_cast<size_t>(config.keyframeInterval) + 1);
+    }
+
+    /**
+     * @brief Adds a viewer, preloaded with the frames since the last keyframe.
+     */
+    shared_ptr<Spectator> subscribe() {
+        auto spectator = make_shared<Spectator>(config.queueCapacity);
+        lock_guard<mutex> lock(spectatorsMutex);
+        for (const BroadcastFramePtr& frame : sinceKeyframe) {
+            spectator->tryPush(frame);
+        }
+        spectators.push_back(spectator);
+        return spectator;
+    }
+
+    /**
+     * @brief Starts (or restarts) the broadcast with a keyframe of the current state.
+     */
+    template<typename Simulation>
+    void publishStart(const Simulation& game) {
+        ticksSinceKeyframe = 0;
+        fanOut(encoder.encodeKeyframe(game));
+    }
+
+    /**
+     * @brief Broadcasts the tick that produced `delta` (game thread).
+     *
+     * Every keyframeInterval ticks the frame is a keyframe of the state
+     * after the tick instead of a delta.
+     */
+    template<typename Simulation>
+    void publishTick(const Simulation& game, const GameDelta& delta) {
+        if (++ticksSinceKeyframe >= config.keyframeInterval) {
+            ticksSinceKeyframe = 0;
+            fanOut(encoder.encodeKeyframe(game));
+        } else {
+            fanOut(encoder.encodeDelta(delta));
+        }
+    }
+
+    size_t getSpectatorCount() {
+        lock_guard<mutex> lock(spectatorsMutex);
+        return spectators.size();
+    }
+
+    uint64_t getFramesEncoded() const { return framesEncoded; }
+    uint64_t getBytesEncoded() const { return bytesEncoded; }
+};
+
+#endif // BROADCAST_H
@@ -0,0 +1,589 @@
+// checkpoint.h
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "gameLogic.h"
+#include <cerrno>
+#include <string>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// ============================================================================
+// CHECKPOINT FILE FORMAT
+// ============================================================================
+//
+//   CheckpointHeader     fixed 128 bytes: dimensions, scalars, food, queued
+//                        presses, random stream position, section offsets
+//   cells                2 bits per cell (CellType), row-major, four cells
+//                        per byte from the low bits up
+//   body                 2 bits per segment after the head: the Direction
+//                        from the previous segment, packed the same way
+//
+// Sections start on 8-byte boundaries and all integers are little-endian,
+// so a mapped checkpoint is read in place: the header is a struct, cells
+// are one shift and mask away, and the body is walked from the head. A
+// 1024x1024 board costs 256 KB of cells plus a quarter byte per segment.
+
+constexpr uint32_t CHECKPOINT_MAGIC = 0x4B434E53;     ///< "SNCK"
+constexpr uint16_t CHECKPOINT_VERSION = 1;
+
+struct CheckpointHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    int32_t rows;
+    int32_t cols;
+    uint64_t tick;
+    uint64_t randomDraws;
+    uint32_t seed;
+    int32_t score;
+    int32_t pointsPerFood;
+    int32_t growthPending;
+    uint32_t snakeLength;
+    uint32_t head;                   ///< Packed cell index, meaningless if snakeLength is 0
+    int32_t food;                    ///< Packed cell index, -1 if none
+    uint8_t gameOver;
+    uint8_t gameOverCause;
+    uint8_t direction;
+    uint8_t pendingInputCount;
+    uint8_t pendingInputs[DirectionController::INPUT_CAPACITY];
+    uint64_t cellsOffset;
+    uint64_t cellsBytes;
+    uint64_t bodyOffset;
+    uint64_t bodyBytes;
+    uint64_t fileSize;
+    uint32_t reserved[2];
+};
+static_assert(sizeof(CheckpointHeader) == 128, "CheckpointHeader layout is part of the file format");
+
+// ============================================================================
+// WRITING
+// ============================================================================
+
+/**
+ * @brief Serializes a running game into the checkpoint format.
+ */
+class Checkpoint {
+private:
+    static uint64_t padded(uint64_t bytes) { return (bytes + 7) & ~uint64_t(7); }
+
+    /**
+     * @brief Appends bit fields to a little-endian stream, a word at a time.
+     *
+     * The destination must have room for whole words past the last bit.
+     */
+    class BitWriter {
+    private:
+        uint8_t* out;
+        uint64_t pending = 0;
+        int used = 0;
+
+    public:
+        explicit BitWriter(uint8_t* destination) : out(destination) {}
+
+        /// Appends the low `count` bits of `bits` (1-64; higher bits must be 0)
+        void put(uint64_t bits, int count) {
+            pending |= bits << used;
+            if (used + count < 64) {
+                used += count;
+                return;
+            }
+            memcpy(out, &pending, sizeof(pending));
+            out += sizeof(pending);
+            pending = used ? bits >> (64 - used) : 0;
+            used = used + count - 64;
+        }
+
+        void flush() {
+            if (used) memcpy(out, &pending, sizeof(pending));
+        }
+    };
+
+    /**
+     * @brief Moves the 32 bits of `x` to the even bit positions.
+     */
+    static uint64_t spreadBits(uint32_t x) {
+#if defined(__BMI2__)
+        return _pdep_u64(x, 0x5555555555555555ull);
+#else
+        uint64_t v = x;
+        v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+        v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+        v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+        v = (v | (v << 2)) & 0x3333333333333333ull;
+        v = (v | (v << 1)) & 0x5555555555555555ull;
+        return v;
+#endif
+    }
+
+    /**
+     * @brief Packs the board two bits per cell from its bit planes, 64 cells per step.
+     *
+     * A cell's low bit is SNAKE or WALL and its high bit FOOD or WALL, which
+     * are exactly the CellType values.
+     */
+    template<typename BoardT>
+    static void packCells(const BoardT& board, uint8_t* out) {
+        const auto& snake = board.getOccupancy(SNAKE);
+        const auto& food = board.getOccupancy(FOOD);
+        const auto& wall = board.getOccupancy(WALL);
+        int words = snake.getWordsPerRow();
+        int tailCells = board.getCols() - (words - 1) * 64;
+        BitWriter writer(out);
+
+        for (int r = 0; r < board.getRows(); r++) {
+            const uint64_t* snakeRow = snake.row(r);
+            const uint64_t* foodRow = food.row(r);
+            const uint64_t* wallRow = wall.row(r);
+            for (int w = 0; w < words; w++) {
+                uint64_t low = snakeRow[w] | wallRow[w];
+                uint64_t high = foodRow[w] | wallRow[w];
+                uint64_t first = spreadBits(static_cast<uint32_t>(low)) |
+                                 (spreadBits(static_cast<uint32_t>(high)) << 1);
+                uint64_t second = spreadBits(static_cast<uint32_t>(low >> 32)) |
+                                  (spreadBits(static_cast<uint32_t>(high >> 32)) << 1);
+                int cells = w + 1 < words ? 64 : tailCells;
+                if (cells == 64) {
+                    writer.put(first, 64);
+                    writer.put(second, 64);
+                } else if (cells >= 32) {
+                    writer.put(first, 64);
+                    if (cells > 32) writer.put(second & (~uint64_t(0) >> (128 - 2 * cells)), 2 * (cells - 32));
+                } else {
+                    writer.put(first & ((uint64_t(1) << (2 * cells)) - 1), 2 * cells);
+                }
+            }
+        }
+        writer.flush();
+    }
+
+    /**
+     * @brief Squeezes `count` one-byte codes (0-3) four to a byte.
+     *
+     * Reads and writes whole groups of eight, so `count` is rounded up and
+     * the codes past it must be 0.
+     */
+    static void packCodes(const uint8_t* codes, size_t count, uint8_t* out) {
+        for (size_t i = 0; i < count; i += 8) {
+            uint64_t word;
+            memcpy(&word, codes + i, sizeof(word));
+            word = (word | (word >> 6)) & 0x000F000F000F000Full;
+            word = (word | (word >> 12)) & 0x000000FF000000FFull;
+            out[i / 4] = static_cast<uint8_t>(word);
+            out[i / 4 + 1] = static_cast<uint8_t>(word >> 32);
+        }
+    }
+
+    /**
+     * @brief Codes the steps into cells[0..n) from their predecessors (cells[-1] = `previous`).
+     */
+    static void codeSteps(const int32_t* cells, int32_t previous, size_t n, int32_t horizontal, uint8_t* codes) {
+        // UP, DOWN, LEFT, RIGHT = (horizontal << 1) | positive
+        int32_t step = cells[0] - previous;
+        codes[0] = static_cast<uint8_t>((((step == horizontal) | (step == -horizontal)) << 1) | (step > 0));
+        size_t i = 1;
+#if defined(__SSE2__)
+        const __m128i left = _mm_set1_epi32(-horizontal);
+        const __m128i right = _mm_set1_epi32(horizontal);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i two = _mm_set1_epi32(2);
+        for (; i + 16 <= n; i += 16) {
+            __m128i lanes[4];
+            for (int k = 0; k < 4; k++) {
+                const int32_t* at = cells + i + 4 * k;
+                __m128i steps = _mm_sub_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(at)),
+                                              _mm_loadu_si128(reinterpret_cast<const __m128i*>(at - 1)));
+                __m128i isHorizontal = _mm_or_si128(_mm_cmpeq_epi32(steps, left), _mm_cmpeq_epi32(steps, right));
+                lanes[k] = _mm_or_si128(_mm_and_si128(isHorizontal, two),
+                                        _mm_and_si128(_mm_cmpgt_epi32(steps, zero), one));
+            }
+            __m128i bytes = _mm_packus_epi16(_mm_packs_epi32(lanes[0], lanes[1]), _mm_packs_epi32(lanes[2], lanes[3]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(codes + i), bytes);
+        }
+#endif
+        for (; i < n; i++) {
+            step = cells[i] - cells[i - 1];
+            codes[i] = static_cast<uint8_t>((((step == horizontal) | (step == -horizontal)) << 1) | (step > 0));
+        }
+    }
+
+    /**
+     * @brief Packs the body as one 2-bit Direction per step from the head.
+     *
+     * Steps are coded into a byte block by a loop the compiler vectorizes,
+     * and each full block is then squeezed four codes to a byte.
+     */
+    static void packBody(const SnakeBodyView& body, int stride, uint8_t* out) {
+        if (body.size() < 2) return;
+        constexpr size_t BLOCK = 256;
+        uint8_t codes[BLOCK + 8];
+        size_t fill = 0;
+        int32_t horizontal = stride == 1 ? 0 : 1;  // One column: every step is vertical
+        int32_t previous = static_cast<int32_t>(body[0]);
+
+        auto append = [&](span<const uint32_t> cells) {
+            const int32_t* values = reinterpret_cast<const int32_t*>(cells.data());
+            for (size_t begin = 0; begin < cells.size();) {
+                size_t n = min(BLOCK - fill, cells.size() - begin);
+                codeSteps(values + begin, previous, n, horizontal, codes + fill);
+                previous = values[begin + n - 1];
+                begin += n;
+                fill += n;
+                if (fill == BLOCK) {
+                    packCodes(codes, BLOCK, out);
+                    out += BLOCK / 4;
+                    fill = 0;
+                }
+            }
+        };
+        append(body.first.subspan(1));
+        append(body.second);
+        memset(codes + fill, 0, 8);
+        packCodes(codes, fill, out);
+    }
+
+public:
+    /**
+     * @brief Bytes a checkpoint of this game takes.
+     */
+    template<typename Simulation>
+    static size_t sizeOf(const Simulation& game) {
+        uint64_t cells = static_cast<uint64_t>(game.getBoard().getCellCount());
+        uint64_t segments = game.getSnake().getLength();
+        return sizeof(CheckpointHeader) + padded((cells + 3) / 4) + padded(((segments > 0 ? segments - 1 : 0) + 3) / 4);
+    }
+
+    /**
+     * @brief Writes a checkpoint into `out` (logic thread, between ticks).
+     *
+     * `out` is resized to fit; reusing one buffer makes later saves
+     * allocation-free.
+     * @param game A BasicSnakeSimulation over a dense board
+     */
+    template<typename Simulation>
+    static void save(const Simulation& game, vector<uint8_t>& out) {
+        static_assert(!Simulation::BoardType::IS_SPARSE,
+                      "Checkpoints pack the board from its bit planes, which a sparse board does not have");
+        const auto& board = game.getBoard();
+        SnakeBodyView body = game.getSnake().getBody();
+        ResumeState state = game.getResumeState();
+
+        size_t size = sizeOf(game);
+        out.resize(size);
+
+        CheckpointHeader header = {};
+        header.magic = CHECKPOINT_MAGIC;
+        header.version = CHECKPOINT_VERSION;
+        header.headerSize = sizeof(CheckpointHeader);
+        header.rows = board.getRows();
+        header.cols = board.getCols();
+        header.tick = state.tick;
+        header.randomDraws = state.randomDraws;
+        header.seed = state.seed;
+        header.score = state.score;
+        header.pointsPerFood = state.pointsPerFood;
+        header.growthPending = state.growthPending;
+        header.snakeLength = static_cast<uint32_t>(body.size());
+        header.head = body.size() > 0 ? body[0] : 0;
+        header.food = state.food;
+        header.gameOver = state.gameOver ? 1 : 0;
+        header.gameOverCause = static_cast<uint8_t>(state.gameOverCause);
+        header.direction = static_cast<uint8_t>(state.direction);
+        header.pendingInputCount = static_cast<uint8_t>(state.pendingInputCount);
+        for (size_t i = 0; i < state.pendingInputCount; i++) {
+            header.pendingInputs[i] = static_cast<uint8_t>(state.pendingInputs[i]);
+        }
+        header.cellsOffset = sizeof(CheckpointHeader);
+        header.cellsBytes = (static_cast<uint64_t>(board.getCellCount()) + 3) / 4;
+        header.bodyOffset = header.cellsOffset + padded(header.cellsBytes);
+        header.bodyBytes = ((body.size() > 0 ? body.size() - 1 : 0) + 3) / 4;
+        header.fileSize = size;
+
+        memcpy(out.data(), &header, sizeof(header));
+        uint8_t* cells = out.data() + header.cellsOffset;
+        uint8_t* segments = out.data() + header.bodyOffset;
+        memset(cells, 0, header.bodyOffset - header.cellsOffset);
+        memset(segments, 0, size - header.bodyOffset);
+        packCells(board, cells);
+        packBody(body, board.getStride(), segments);
+    }
+
+    /**
+     * @brief Saves a checkpoint to a file, replacing any previous one atomically.
+     * @return False if the file could not be written
+     */
+    template<typename Simulation>
+    static bool saveFile(const Simulation& game, const string& path) {
+        vector<uint8_t> bytes;
+        save(game, bytes);
+        string tempPath = path + ".tmp";
+#ifdef _WIN32
+        HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        DWORD count = 0;
+        bool ok = WriteFile(file, bytes.data(), static_cast<DWORD>(bytes.size()), &count, nullptr) &&
+                  count == bytes.size() && FlushFileBuffers(file);
+        CloseHandle(file);
+        return ok && MoveFileExA(tempPath.c_str(), path.c_str(),
+                                 MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        int fd = ::open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = true;
+        for (size_t written = 0; ok && written < bytes.size();) {
+            ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            ok = n > 0;
+            if (ok) written += static_cast<size_t>(n);
+        }
+        ok = ok && fsync(fd) == 0;
+        ok = ::close(fd) == 0 && ok;
+        if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+            unlink(tempPath.c_str());
+            return false;
+        }
+        return true;
+#endif
+    }
+};
+
+// ============================================================================
+// READING
+// ============================================================================
+
+/**
+ * @brief Read-only view of a checkpoint, either a mapped file or a buffer.
+ *
+ * Opening only checks the header against the size; nothing is parsed or
+ * copied until restore().
+ */
+class CheckpointView {
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    const uint8_t* base = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+
+    bool validate() const {
+        if (size < sizeof(CheckpointHeader)) return false;
+        const CheckpointHeader& h = header();
+        if (h.magic != CHECKPOINT_MAGIC || h.version != CHECKPOINT_VERSION ||
+            h.headerSize != sizeof(CheckpointHeader) || h.fileSize != size) {
+            return false;
+        }
+        if (h.rows <= 0 || h.cols <= 0) return false;
+        uint64_t cells = static_cast<uint64_t>(h.rows) * static_cast<uint64_t>(h.cols);
+        if (cells > (uint64_t(1) << 31) || h.snakeLength > cells) return false;
+        if (h.cellsBytes != (cells + 3) / 4 || h.cellsOffset < sizeof(CheckpointHeader) ||
+            h.cellsOffset > size || h.cellsBytes > size - h.cellsOffset) {
+            return false;
+        }
+        uint64_t segments = h.snakeLength > 0 ? h.snakeLength - 1 : 0;
+        if (h.bodyBytes < (segments + 3) / 4 || h.bodyOffset < h.cellsOffset + h.cellsBytes ||
+            h.bodyOffset > size || h.bodyBytes > size - h.bodyOffset) {
+            return false;
+        }
+        if (h.snakeLength > 0 && h.head >= cells) return false;
+        if (h.food >= 0 && static_cast<uint64_t>(h.food) >= cells) return false;
+        return h.direction <= NONE && h.gameOverCause <= BOARD_FILLED &&
+               h.pendingInputCount <= DirectionController::INPUT_CAPACITY;
+    }
+
+public:
+    CheckpointView() = default;
+    CheckpointView(const CheckpointView&) = delete;
+    CheckpointView& operator=(const CheckpointView&) = delete;
+
+    ~CheckpointView() {
+        close();
+    }
+
+    /**
+     * @brief Views a checkpoint held in memory (the buffer must outlive the view).
+     * @return False if it is not a checkpoint of this version
+     */
+    bool attach(const uint8_t* data, size_t length) {
+        close();
+        base = data;
+        size = length;
+        if (!validate()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Maps a checkpoint file read-only.
+     * @return False if the file cannot be mapped or is not a checkpoint of this version
+     */
+    bool open(const string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER fileSize = {};
+        if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) base = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            size = static_cast<size_t>(fileSize.QuadPart);
+        }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat info;
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (view != MAP_FAILED) base = static_cast<const uint8_t*>(view);
+            size = static_cast<size_t>(info.st_size);
+        }
+#endif
+        mapped = base != nullptr;
+        if (!base || !validate()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (mapped) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (mapped) munmap(const_cast<uint8_t*>(base), size);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        base = nullptr;
+        size = 0;
+        mapped = false;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+
+    const CheckpointHeader& header() const {
+        return *reinterpret_cast<const CheckpointHeader*>(base);
+    }
+
+    /**
+     * @brief Reads one cell in place.
+     * @param index Row-major cell index
+     * @return CellType of the cell
+     */
+    int cellAt(int index) const {
+        const uint8_t* cells = base + header().cellsOffset;
+        return (cells[index >> 2] >> ((index & 3) * 2)) & 3;
+    }
+
+    /**
+     * @brief Direction from body segment i - 1 to segment i, for i >= 1.
+     */
+    Direction segmentStep(size_t i) const {
+        const uint8_t* body = base + header().bodyOffset;
+        return static_cast<Direction>((body[(i - 1) >> 2] >> (((i - 1) & 3) * 2)) & 3);
+    }
+
+    /**
+     * @brief Unpacks the body into packed cell indices, head first.
+     * @return False if the body leaves the board or crosses itself
+     */
+    bool decodeBody(vector<uint32_t>& body) const {
+        const CheckpointHeader& h = header();
+        body.resize(h.snakeLength);
+        if (h.snakeLength == 0) return true;
+
+        vector<uint64_t> seen((static_cast<size_t>(h.rows) * h.cols + 63) / 64, 0);
+        int r = static_cast<int>(h.head / static_cast<uint32_t>(h.cols));
+        int c = static_cast<int>(h.head % static_cast<uint32_t>(h.cols));
+        for (size_t i = 0; i < h.snakeLength; i++) {
+            if (i > 0) {
+                switch (segmentStep(i)) {
+                    case UP:    r--; break;
+                    case DOWN:  r++; break;
+                    case LEFT:  c--; break;
+                    default:    c++; break;
+                }
+                if (r < 0 || r >= h.rows || c < 0 || c >= h.cols) return false;
+            }
+            uint32_t cell = static_cast<uint32_t>(r * h.cols + c);
+            uint64_t bit = uint64_t(1) << (cell & 63);
+            if (seen[cell >> 6] & bit) return false;
+            seen[cell >> 6] |= bit;
+            body[i] = cell;
+        }
+        return true;
+    }
+
+    /**
+     * @brief The header's scalars in the form restore() takes.
+     */
+    ResumeState resumeState() const {
+        const CheckpointHeader& h = header();
+        ResumeState state = {};
+        state.tick = h.tick;
+        state.score = h.score;
+        state.pointsPerFood = h.pointsPerFood;
+        state.gameOver = h.gameOver != 0;
+        state.gameOverCause = static_cast<GameOverCause>(h.gameOverCause);
+        state.seed = h.seed;
+        state.randomDraws = h.randomDraws;
+        state.growthPending = h.growthPending;
+        state.food = h.food;
+        state.direction = static_cast<Direction>(h.direction);
+        state.pendingInputCount = h.pendingInputCount;
+        for (size_t i = 0; i < state.pendingInputCount; i++) {
+            state.pendingInputs[i] = static_cast<Direction>(min<uint8_t>(h.pendingInputs[i], NONE));
+        }
+        return state;
+    }
+
+    /**
+     * @brief Resumes the checkpointed game.
+     * @param game A BasicSnakeSimulation or BasicSnakeGameLogic; a fixed board
+     *             must have the checkpoint's dimensions
+     * @return False if the dimensions do not fit or the snake or food is invalid
+     */
+    template<typename Game>
+    bool restore(Game& game) const {
+        if (!base) return false;
+        const CheckpointHeader& h = header();
+        using BoardT = typename Game::BoardType;
+        if constexpr (BoardT::IS_FIXED) {
+            if (h.rows != BoardT::ROWS || h.cols != BoardT::COLS) return false;
+        }
+
+        vector<uint32_t> body;
+        if (!decodeBody(body)) return false;
+        if (h.food >= 0 && cellAt(h.food) != FOOD) return false;
+        for (uint32_t cell : body) {
+            if (static_cast<int32_t>(cell) == h.food) return false;
+        }
+        game.restore(h.rows, h.cols, body, resumeState());
+        return true;
+    }
+};
+
+#endif // CHECKPOINT_H
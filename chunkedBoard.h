@@ -0,0 +1,282 @@
+// chunkedBoard.h
+#ifndef CHUNKEDBOARD_H
+#define CHUNKEDBOARD_H
+
+#include <climits>
+#include <memory>
+#include "gameLogic.h"
+
+// ============================================================================
+// CHUNKED BOARD
+// ============================================================================
+//
+// Board storage for maps far larger than a dense buffer allows. The board is
+// cut into 64x64 tiles; a tile is allocated the first time one of its cells
+// becomes non-EMPTY and handed back to a spare pool once it is all EMPTY
+// again, so tiles that were never touched cost nothing. Tiles are found
+// through an open-addressed table keyed by tile number, which grows with the
+// occupied area rather than with the board.
+//
+// ChunkedBoard keeps no free list and no bit planes: the free count is the
+// cell count minus the occupied cells, and food is placed by drawing cells
+// until an EMPTY one turns up (see FoodManager::placeRandom()), which takes
+// about one draw on a board this sparse. Cell indices stay `int`, so a board
+// holds at most INT_MAX cells (e.g. 46340 x 46340).
+
+/**
+ * @brief Sparse board of lazily allocated tiles; EMPTY tiles are implicit.
+ *
+ * Satisfies the board interface the simulation uses (bounds, indexing, cell
+ * reads and writes, free count), plus copyWindow() for publishing a
+ * viewport instead of the whole board.
+ */
+class ChunkedBoard {
+public:
+    static constexpr bool IS_FIXED = false;
+    static constexpr bool IS_SPARSE = true;
+    static constexpr int ROWS = 0;
+    static constexpr int COLS = 0;
+
+    static constexpr int TILE_SHIFT = 6;
+    static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+    static constexpr int TILE_CELLS = TILE_SIZE * TILE_SIZE;
+
+    /// Largest board this type supports (cell indices are int)
+    static constexpr int64_t MAX_CELLS = INT_MAX;
+
+    /// Boards above this many cells are played on a ChunkedBoard (see GameSession)
+    static constexpr int64_t HUGE_BOARD_CELLS = int64_t(4096) * 4096;
+
+private:
+    static constexpr uint32_t NO_TILE = 0;
+    static constexpr size_t MIN_TABLE_SIZE = 64;
+
+    struct Tile {
+        uint8_t cells[TILE_CELLS];
+        int occupied;                ///< Non-EMPTY cells in this tile
+    };
+
+    vector<unique_ptr<Tile>> tiles;  ///< Every tile ever allocated, live or spare
+    vector<uint32_t> spareTiles;     ///< Tiles available for reuse, all EMPTY
+
+    // Open-addressed tile table with linear probing
+    vector<uint32_t> tableKeys;      ///< Tile number + 1, NO_TILE for a free slot
+    vector<uint32_t> tableTiles;     ///< Index into `tiles`
+    size_t liveTiles;
+
+    int rows;
+    int cols;
+    int tileCols;
+    int occupiedCells;
+
+    size_t slotFor(uint32_t key) const {
+        return (key * 0x9E3779B1u) & (tableKeys.size() - 1);
+    }
+
+    uint32_t tileKey(int r, int c) const {
+        return static_cast<uint32_t>((r >> TILE_SHIFT) * tileCols + (c >> TILE_SHIFT)) + 1;
+    }
+
+    static int tileOffset(int r, int c) {
+        return ((r & (TILE_SIZE - 1)) << TILE_SHIFT) | (c & (TILE_SIZE - 1));
+    }
+
+    Tile* findTile(uint32_t key) const {
+        for (size_t slot = slotFor(key); ; slot = (slot + 1) & (tableKeys.size() - 1)) {
+            if (tableKeys[slot] == key) return tiles[tableTiles[slot]].get();
+            if (tableKeys[slot] == NO_TILE) return nullptr;
+        }
+    }
+
+    void insertSlot(uint32_t key, uint32_t tile) {
+        size_t slot = slotFor(key);
+        while (tableKeys[slot] != NO_TILE) slot = (slot + 1) & (tableKeys.size() - 1);
+        tableKeys[slot] = key;
+        tableTiles[slot] = tile;
+    }
+
+    void resizeTable(size_t size) {
+        vector<uint32_t> keys(size, NO_TILE);
+        vector<uint32_t> indices(size, 0);
+        keys.swap(tableKeys);
+        indices.swap(tableTiles);
+        for (size_t i = 0; i < keys.size(); i++) {
+            if (keys[i] != NO_TILE) insertSlot(keys[i], indices[i]);
+        }
+    }
+
+    Tile* createTile(uint32_t key) {
+        if ((liveTiles + 1) * 2 > tableKeys.size()) resizeTable(tableKeys.size() * 2);
+
+        uint32_t tile;
+        if (!spareTiles.empty()) {
+            tile = spareTiles.back();
+            spareTiles.pop_back();
+        } else {
+            tile = static_cast<uint32_t>(tiles.size());
+            tiles.push_back(make_unique<Tile>());  // Value-initialized: all EMPTY
+        }
+        insertSlot(key, tile);
+        liveTiles++;
+        return tiles[tile].get();
+    }
+
+    /**
+     * @brief Drops an all-EMPTY tile from the table (backward-shift delete,
+     * so lookups never need tombstones).
+     */
+    void releaseTile(uint32_t key) {
+        size_t mask = tableKeys.size() - 1;
+        size_t slot = slotFor(key);
+        while (tableKeys[slot] != key) slot = (slot + 1) & mask;
+        spareTiles.push_back(tableTiles[slot]);
+        liveTiles--;
+
+        size_t hole = slot;
+        for (size_t next = (hole + 1) & mask; tableKeys[next] != NO_TILE; next = (next + 1) & mask) {
+            size_t home = slotFor(tableKeys[next]);
+            // Move the entry back unless its home lies in (hole, next]
+            if (((next - home) & mask) >= ((next - hole) & mask)) {
+                tableKeys[hole] = tableKeys[next];
+                tableTiles[hole] = tableTiles[next];
+                hole = next;
+            }
+        }
+        tableKeys[hole] = NO_TILE;
+    }
+
+public:
+    ChunkedBoard() : liveTiles(0), rows(0), cols(0), tileCols(0), occupiedCells(0) {}
+
+    /**
+     * @brief Initializes an all-EMPTY board; tiles already allocated are kept as spares.
+     * @param rows Number of rows
+     * @param cols Number of columns (rows * cols at most MAX_CELLS)
+     */
+    void initialize(int rows, int cols) {
+        for (size_t i = 0; i < tableKeys.size(); i++) {
+            if (tableKeys[i] == NO_TILE) continue;
+            Tile& tile = *tiles[tableTiles[i]];
+            memset(tile.cells, EMPTY, TILE_CELLS);
+            tile.occupied = 0;
+            spareTiles.push_back(tableTiles[i]);
+        }
+        tableKeys.assign(MIN_TABLE_SIZE, NO_TILE);
+        tableTiles.assign(MIN_TABLE_SIZE, 0);
+        liveTiles = 0;
+
+        this->rows = rows;
+        this->cols = cols;
+        tileCols = (cols + TILE_SIZE - 1) >> TILE_SHIFT;
+        occupiedCells = 0;
+    }
+
+    bool isInBounds(int r, int c) const {
+        return r >= 0 && r < rows && c >= 0 && c < cols;
+    }
+
+    int toIndex(int r, int c) const {
+        return r * cols + c;
+    }
+
+    /**
+     * @brief Gets the cell type at a position (WALL outside the board).
+     */
+    int getCellType(int r, int c) const {
+        if (!isInBounds(r, c)) return WALL;
+        const Tile* tile = findTile(tileKey(r, c));
+        return tile ? tile->cells[tileOffset(r, c)] : static_cast<int>(EMPTY);
+    }
+
+    /**
+     * @brief Gets the cell type at a row-major index (no bounds check).
+     */
+    int getCell(int index) const {
+        int r = index / cols;
+        return getCellType(r, index - r * cols);
+    }
+
+    void setCellType(int r, int c, int cellType) {
+        if (isInBounds(r, c)) {
+            setCell(toIndex(r, c), cellType);
+        }
+    }
+
+    /**
+     * @brief Sets the cell type at a row-major index (no bounds check).
+     *
+     * Allocates the tile on its first non-EMPTY cell and releases it when
+     * its last one is cleared.
+     */
+    void setCell(int index, int cellType) {
+        int r = index / cols;
+        int c = index - r * cols;
+        uint32_t key = tileKey(r, c);
+        Tile* tile = findTile(key);
+        int previous = tile ? tile->cells[tileOffset(r, c)] : static_cast<int>(EMPTY);
+        if (previous == cellType) return;
+        if (!tile) tile = createTile(key);
+
+        tile->cells[tileOffset(r, c)] = static_cast<uint8_t>(cellType);
+        if (previous == EMPTY) {
+            tile->occupied++;
+            occupiedCells++;
+        } else if (cellType == EMPTY) {
+            occupiedCells--;
+            if (--tile->occupied == 0) releaseTile(key);
+        }
+    }
+
+    int getFreeCellCount() const {
+        return getCellCount() - occupiedCells;
+    }
+
+    /**
+     * @brief Copies a window of cells into a row-major buffer (`height * width` bytes).
+     *
+     * Cost is proportional to the window; tiles that are not allocated are
+     * filled with EMPTY. The window must lie inside the board.
+     */
+    void copyWindow(int row, int col, int height, int width, uint8_t* out) const {
+        for (int r = row; r < row + height; ) {
+            int bandEnd = min(row + height, ((r >> TILE_SHIFT) + 1) << TILE_SHIFT);
+            for (int c = col; c < col + width; ) {
+                int spanEnd = min(col + width, ((c >> TILE_SHIFT) + 1) << TILE_SHIFT);
+                const Tile* tile = findTile(tileKey(r, c));
+                for (int y = r; y < bandEnd; y++) {
+                    uint8_t* dst = out + static_cast<size_t>(y - row) * width + (c - col);
+                    if (tile) {
+                        memcpy(dst, tile->cells + tileOffset(y, c), spanEnd - c);
+                    } else {
+                        memset(dst, EMPTY, spanEnd - c);
+                    }
+                }
+                c = spanEnd;
+            }
+            r = bandEnd;
+        }
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getStride() const { return cols; }
+    int getCellCount() const { return rows * cols; }
+
+    /// Tiles holding at least one non-EMPTY cell
+    size_t getTileCount() const { return liveTiles; }
+
+    /// Heap held by tiles and the tile table, spares included
+    size_t getMemoryBytes() const {
+        return tiles.size() * sizeof(Tile) + tableKeys.size() * 2 * sizeof(uint32_t) +
+               spareTiles.capacity() * sizeof(uint32_t);
+    }
+
+    /**
+     * @brief Whether a board of this size should use ChunkedBoard.
+     */
+    static bool isHuge(int rows, int cols) {
+        return static_cast<int64_t>(rows) * cols > HUGE_BOARD_CELLS;
+    }
+};
+
+#endif // CHUNKEDBOARD_H
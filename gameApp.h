@@ -0,0 +1,2002 @@
+// gameApp.h
+#ifndef GAMEAPP_H
+#define GAMEAPP_H
+
+#include "gameLogic.h"
+#include "chunkedBoard.h"
+#include "replay.h"
+#include "leaderboard.h"
+#include "autopilot.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <fstream>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include <string>
+#include <charconv>
+#include <algorithm>
+#include <cstdio>
+
+#ifdef _WIN32
+    #include <conio.h>
+    #include <windows.h>
+    #ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+        #define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+    #endif
+#else
+    #include <unistd.h>
+    #include <termios.h>
+    #include <fcntl.h>
+    #include <poll.h>
+    #include <sys/ioctl.h>
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+using namespace std;
+
+// ============================================
+// Event System for Extensibility
+// ============================================
+
+enum class EventType {
+    FOOD_EATEN,
+    SNAKE_GREW,
+    GAME_OVER,
+    SCORE_CHANGED,
+    HIGH_SCORE_BEATEN
+};
+
+constexpr size_t EVENT_TYPE_COUNT = static_cast<size_t>(EventType::HIGH_SCORE_BEATEN) + 1;
+
+/**
+ * @brief Event payload; plain data so raising one never allocates.
+ */
+struct GameEvent {
+    EventType type;
+    int value;          // Score for score/game-over events, length for SNAKE_GREW
+    uint64_t tick;      // Game tick that raised the event
+};
+static_assert(is_trivially_copyable_v<GameEvent>, "GameEvent must stay plain data");
+
+/**
+ * @brief Events raised by one tick, dispatched together once it completes.
+ */
+class EventBatch {
+public:
+    static constexpr size_t CAPACITY = 8;
+    
+private:
+    GameEvent events[CAPACITY];
+    size_t count = 0;
+    
+public:
+    void clear() { count = 0; }
+    
+    void push(const GameEvent& event) {
+        if (count < CAPACITY) events[count++] = event;
+    }
+    
+    /**
+     * @brief Refills the batch with the events a tick's delta implies.
+     * @param delta Delta of the tick
+     * @param score Score after the tick
+     * @param length Snake length after the tick
+     */
+    void collectTick(const GameDelta& delta, int score, int length) {
+        count = 0;
+        if (delta.foodRemoved >= 0) {
+            push({EventType::FOOD_EATEN, score, delta.tick});
+        }
+        if (delta.headAdded >= 0 && delta.tailRemoved < 0) {
+            push({EventType::SNAKE_GREW, length, delta.tick});
+        }
+        if (delta.scoreDelta != 0) {
+            push({EventType::SCORE_CHANGED, score, delta.tick});
+        }
+        if (delta.gameOver) {
+            push({EventType::GAME_OVER, score, delta.tick});
+        }
+    }
+    
+    bool empty() const { return count == 0; }
+    size_t size() const { return count; }
+    const GameEvent* begin() const { return events; }
+    const GameEvent* end() const { return events + count; }
+};
+
+class EventListener {
+public:
+    virtual ~EventListener() = default;
+    virtual void onEvent(const GameEvent& event) = 0;
+};
+
+/**
+ * @brief Runtime subscription table, for listeners chosen while running.
+ * 
+ * A flat array indexed by EventType with a fixed number of slots per type,
+ * so subscribing and notifying never allocate or search.
+ */
+class EventManager {
+public:
+    static constexpr size_t MAX_LISTENERS_PER_EVENT = 8;
+    
+private:
+    EventListener* listeners[EVENT_TYPE_COUNT][MAX_LISTENERS_PER_EVENT] = {};
+    uint8_t listenerCounts[EVENT_TYPE_COUNT] = {};
+    
+public:
+    /**
+     * @return False if every slot for this event type is taken
+     */
+    bool subscribe(EventType type, EventListener* listener) {
+        size_t slot = static_cast<size_t>(type);
+        if (listenerCounts[slot] == MAX_LISTENERS_PER_EVENT) return false;
+        listeners[slot][listenerCounts[slot]++] = listener;
+        return true;
+    }
+    
+    bool hasListeners() const {
+        for (uint8_t count : listenerCounts) {
+            if (count > 0) return true;
+        }
+        return false;
+    }
+    
+    void notify(const GameEvent& event) {
+        size_t slot = static_cast<size_t>(event.type);
+        for (uint8_t i = 0; i < listenerCounts[slot]; i++) {
+            listeners[slot][i]->onEvent(event);
+        }
+    }
+    
+    void notify(const EventBatch& batch) {
+        for (const GameEvent& event : batch) {
+            notify(event);
+        }
+    }
+};
+
+/**
+ * @brief Compile-time listener list.
+ * 
+ * Calls each listener's `onEvent(const GameEvent&)` directly (no virtual
+ * dispatch or table lookup). With no listeners, notify() is empty and
+ * `isEmpty` lets callers skip building events altogether.
+ */
+template<typename... Listeners>
+class StaticEventDispatcher {
+private:
+    tuple<Listeners&...> listeners;
+    
+public:
+    static constexpr bool isEmpty = sizeof...(Listeners) == 0;
+    
+    explicit StaticEventDispatcher(Listeners&... ls) : listeners(ls...) {}
+    
+    void notify(const GameEvent& event) const {
+        apply([&](auto&... listener) { (listener.onEvent(event), ...); }, listeners);
+    }
+    
+    void notify(const EventBatch& batch) const {
+        if constexpr (!isEmpty) {
+            for (const GameEvent& event : batch) {
+                notify(event);
+            }
+        }
+    }
+};
+
+// ============================================
+// Configuration System
+// ============================================
+
+class GameConfig {
+public:
+    // Board settings
+    int rows;
+    int cols;
+    int startingLength;
+    
+    // Gameplay settings
+    int updateDelay;
+    int pointsPerFood;
+    int maxCatchUpTicks;    // Ticks run back-to-back after a stall before the rest are dropped
+    int maxBufferedTurns;   // Key presses queued for upcoming ticks
+    int maxFrameRate;       // Frames drawn per second at most; 0 = as fast as the terminal drains
+    
+    // Display settings
+    char snakeHeadChar;
+    char snakeBodyChar;
+    char foodChar;
+    char wallChar;
+    char emptyChar;
+    
+    // Reproducibility settings
+    uint32_t seed;          // Food placement seed; 0 = derive from the clock
+    string recordPath;      // Replay log written for each session; empty = off
+    AutopilotMode autopilot; // Automated player steering every tick; AUTOPILOT_OFF = keyboard
+    
+    // Instrumentation settings
+    bool showStats;         // Profiler stats line under the board (needs -DSNAKE_PROFILE)
+    
+    // Leaderboard settings
+    string playerName;      // Name recorded on the leaderboard
+    string leaderboardPath; // Shared leaderboard file; empty = off
+    
+    GameConfig() 
+        : rows(20), cols(40), startingLength(3),
+          updateDelay(150), pointsPerFood(10),
+          maxCatchUpTicks(5), maxBufferedTurns(3), maxFrameRate(60),
+          snakeHeadChar('O'), snakeBodyChar('o'),
+          foodChar('*'), wallChar('#'), emptyChar(' '),
+          seed(0), autopilot(AUTOPILOT_OFF), showStats(false), playerName(defaultPlayerName()),
+          leaderboardPath("game_leaderboard.dat") {}
+    
+    static string defaultPlayerName() {
+        const char* name = getenv("USER");
+        if (!name || !*name) name = getenv("USERNAME");
+        return name && *name ? name : "player";
+    }
+};
+
+// ============================================
+// High Score Persistence
+// ============================================
+
+/**
+ * @brief Write-behind saver for the high score file.
+ * 
+ * submit() only records the value and wakes a background thread; bursts of
+ * new records are coalesced into one write of the latest value. Each write
+ * goes to a temporary file that is fsync'd and atomically renamed over the
+ * real one, so a crash leaves either the old or the new score, never a
+ * truncated file.
+ */
+class HighScorePersister {
+private:
+    string path;
+    mutex stateMutex;
+    condition_variable wake;
+    condition_variable written;
+    int pendingScore;
+    bool hasPending;
+    bool writing;
+    bool stopping;
+    bool lastWriteFailed;
+    thread worker;
+    
+    static bool writeAtomically(const string& path, int score) {
+        SNAKE_PROFILE_SCOPE(PHASE_SCORE_WRITE);
+        string tempPath = path + ".tmp";
+        string text = to_string(score) + "\n";
+#ifdef _WIN32
+        HANDLE file = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        DWORD count = 0;
+        bool ok = WriteFile(file, text.data(), static_cast<DWORD>(text.size()), &count, nullptr) &&
+                  count == text.size() && FlushFileBuffers(file);
+        CloseHandle(file);
+        return ok && MoveFileExA(tempPath.c_str(), path.c_str(),
+                                 MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#else
+        int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) return false;
+        bool ok = write(fd, text.data(), text.size()) == static_cast<ssize_t>(text.size()) &&
+                  fsync(fd) == 0;
+        ok = close(fd) == 0 && ok;
+        if (!ok || rename(tempPath.c_str(), path.c_str()) != 0) {
+            unlink(tempPath.c_str());
+            return false;
+        }
+        
+        // Make the rename itself durable
+        size_t slash = path.find_last_of('/');
+        string directory = slash == string::npos ? "." : path.substr(0, slash + 1);
+        int dirFd = open(directory.c_str(), O_RDONLY);
+        if (dirFd >= 0) {
+            fsync(dirFd);
+            close(dirFd);
+        }
+        return true;
+#endif
+    }
+    
+    void run() {
+        unique_lock<mutex> lock(stateMutex);
+        while (true) {
+            wake.wait(lock, [this] { return hasPending || stopping; });
+            if (!hasPending) break;
+            
+            int score = pendingScore;
+            hasPending = false;
+            writing = true;
+            lock.unlock();
+            bool ok = writeAtomically(path, score);
+            lock.lock();
+            writing = false;
+            lastWriteFailed = !ok;
+            written.notify_all();
+        }
+    }
+    
+public:
+    explicit HighScorePersister(const string& filePath)
+        : path(filePath), pendingScore(0), hasPending(false), writing(false),
+          stopping(false), lastWriteFailed(false) {
+        worker = thread(&HighScorePersister::run, this);
+    }
+    
+    HighScorePersister(const HighScorePersister&) = delete;
+    HighScorePersister& operator=(const HighScorePersister&) = delete;
+    
+    /**
+     * @brief Flushes anything pending and stops the writer thread.
+     */
+    ~HighScorePersister() {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    
+    /**
+     * @brief Schedules `score` to be written; never touches the file itself.
+     */
+    void submit(int score) {
+        {
+            lock_guard<mutex> lock(stateMutex);
+            pendingScore = score;
+            hasPending = true;
+        }
+        wake.notify_one();
+    }
+    
+    /**
+     * @brief Blocks until every submitted score has been written.
+     * @return False if the last write failed
+     */
+    bool flush() {
+        unique_lock<mutex> lock(stateMutex);
+        written.wait(lock, [this] { return !hasPending && !writing; });
+        return !lastWriteFailed;
+    }
+};
+
+// ============================================
+// High Score Manager
+// ============================================
+
+class HighScoreManager final : public EventListener {
+private:
+    const string filename = "game_highest.txt";
+    atomic<int> highScore;  // Updated on the simulation thread, read by the renderer
+    EventManager* eventManager;
+    HighScorePersister persister;
+    
+public:
+    HighScoreManager() : highScore(0), eventManager(nullptr), persister(filename) {
+        loadHighScore();
+    }
+    
+    /**
+     * @brief Sets where HIGH_SCORE_BEATEN is announced (may be null).
+     */
+    void setEventManager(EventManager* em) {
+        eventManager = em;
+    }
+    
+    void onEvent(const GameEvent& event) override {
+        if (event.type == EventType::SCORE_CHANGED) {
+            checkAndSaveHighScore(event.value);
+        }
+    }
+    
+    void loadHighScore() {
+        ifstream file(filename);
+        int stored = 0;
+        if (file.is_open()) {
+            file >> stored;
+            file.close();
+        }
+        highScore = stored;
+    }
+    
+    /**
+     * @brief Records a new high score. Safe to call from the game loop:
+     * the file is written later by the persister thread.
+     */
+    void checkAndSaveHighScore(int score) {
+        int oldHighScore = highScore.load();
+        if (score > oldHighScore) {
+            highScore = score;
+            saveHighScore();
+            
+            if (eventManager && oldHighScore > 0) {
+                eventManager->notify(GameEvent{EventType::HIGH_SCORE_BEATEN, score, 0});
+            }
+        }
+    }
+    
+    void saveHighScore() {
+        persister.submit(highScore.load());
+    }
+    
+    /**
+     * @brief Waits until the high score file is up to date.
+     */
+    bool flush() {
+        return persister.flush();
+    }
+    
+    int getHighScore() const {
+        return highScore;
+    }
+    
+    bool isNewHighScore(int score) const {
+        return score > highScore;
+    }
+};
+
+// ============================================
+// Platform-Independent Terminal Control
+// ============================================
+
+#ifdef _WIN32
+/**
+ * @brief Double-buffered console backend for Windows consoles without VT support.
+ * 
+ * Output is composed into an in-memory CHAR_INFO canvas the size of the
+ * console window. present() copies the whole canvas into the hidden one of
+ * two screen buffers with a single WriteConsoleOutputA() and makes that
+ * buffer active, so a frame never shows half-drawn and a clear is a memory
+ * fill instead of a `cls` process.
+ */
+class ConsoleCanvas {
+private:
+    HANDLE original = INVALID_HANDLE_VALUE;
+    HANDLE buffers[2] = {INVALID_HANDLE_VALUE, INVALID_HANDLE_VALUE};
+    int back = 0;
+    SHORT width = 0;
+    SHORT height = 0;
+    WORD attributes = FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE;
+    vector<CHAR_INFO> cells;
+    int cursorRow = 0;
+    int cursorCol = 0;
+    bool cursorVisible = true;
+    
+    void applyCursor(HANDLE buffer) const {
+        CONSOLE_CURSOR_INFO info;
+        info.dwSize = 100;
+        info.bVisible = cursorVisible ? TRUE : FALSE;
+        SetConsoleCursorInfo(buffer, &info);
+    }
+    
+public:
+    ConsoleCanvas() = default;
+    ConsoleCanvas(const ConsoleCanvas&) = delete;
+    ConsoleCanvas& operator=(const ConsoleCanvas&) = delete;
+    
+    /**
+     * @brief Creates both screen buffers and switches to them.
+     * @return False if the console refused (output then stays on stdout)
+     */
+    bool open() {
+        if (isOpen()) return true;
+        original = GetStdHandle(STD_OUTPUT_HANDLE);
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(original, &info)) return false;
+        width = static_cast<SHORT>(info.srWindow.Right - info.srWindow.Left + 1);
+        height = static_cast<SHORT>(info.srWindow.Bottom - info.srWindow.Top + 1);
+        attributes = info.wAttributes;
+        
+        for (HANDLE& buffer : buffers) {
+            buffer = CreateConsoleScreenBuffer(GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                               nullptr, CONSOLE_TEXTMODE_BUFFER, nullptr);
+            if (buffer == INVALID_HANDLE_VALUE) {
+                close();
+                return false;
+            }
+            SetConsoleScreenBufferSize(buffer, COORD{width, height});
+            applyCursor(buffer);
+        }
+        
+        cells.resize(static_cast<size_t>(width) * height);
+        clear();
+        present();
+        return true;
+    }
+    
+    /**
+     * @brief Switches back to the original buffer and releases both.
+     */
+    void close() {
+        if (original != INVALID_HANDLE_VALUE) SetConsoleActiveScreenBuffer(original);
+        for (HANDLE& buffer : buffers) {
+            if (buffer != INVALID_HANDLE_VALUE) CloseHandle(buffer);
+            buffer = INVALID_HANDLE_VALUE;
+        }
+    }
+    
+    bool isOpen() const { return buffers[0] != INVALID_HANDLE_VALUE; }
+    
+    void clear() {
+        CHAR_INFO blank;
+        blank.Char.AsciiChar = ' ';
+        blank.Attributes = attributes;
+        fill(cells.begin(), cells.end(), blank);
+        cursorRow = 0;
+        cursorCol = 0;
+    }
+    
+    void moveTo(int row, int col) {
+        cursorRow = row;
+        cursorCol = col;
+    }
+    
+    /**
+     * @brief Writes text at the cursor; '\n' starts the next line, anything off-canvas is clipped.
+     */
+    void write(const char* data, size_t size) {
+        for (size_t i = 0; i < size; i++) {
+            char ch = data[i];
+            if (ch == '\n') {
+                cursorRow++;
+                cursorCol = 0;
+            } else if (ch == '\r') {
+                cursorCol = 0;
+            } else {
+                if (cursorRow >= 0 && cursorRow < height && cursorCol >= 0 && cursorCol < width) {
+                    CHAR_INFO& cell = cells[static_cast<size_t>(cursorRow) * width + cursorCol];
+                    cell.Char.AsciiChar = ch;
+                    cell.Attributes = attributes;
+                }
+                cursorCol++;
+            }
+        }
+    }
+    
+    /**
+     * @brief Shows the canvas: one WriteConsoleOutputA() into the hidden buffer, then a swap.
+     */
+    void present() {
+        if (!isOpen()) return;
+        SMALL_RECT region = {0, 0, static_cast<SHORT>(width - 1), static_cast<SHORT>(height - 1)};
+        WriteConsoleOutputA(buffers[back], cells.data(), COORD{width, height}, COORD{0, 0}, &region);
+        SetConsoleActiveScreenBuffer(buffers[back]);
+        back ^= 1;
+    }
+    
+    void setCursorVisible(bool visible) {
+        cursorVisible = visible;
+        for (HANDLE buffer : buffers) {
+            if (buffer != INVALID_HANDLE_VALUE) applyCursor(buffer);
+        }
+    }
+    
+    ~ConsoleCanvas() {
+        close();
+    }
+};
+#endif
+
+class TerminalController {
+private:
+#ifdef _WIN32
+    ConsoleCanvas canvas;
+    DWORD originalOutputMode = 0;
+    bool outputModeChanged = false;
+    bool virtualTerminal = false;
+    HANDLE wakeEvent;
+#else
+    termios originalSettings;
+    bool settingsChanged = false;
+    int originalFlags = 0;
+    int wakePipe[2];
+#endif
+    bool discardOutput = false;
+    bool cursorHidden = false;
+    bool inputClosed = false;
+    uint64_t bytesWritten = 0;
+    uint64_t outputStalls = 0;
+
+public:
+    TerminalController() {
+#ifdef _WIN32
+        wakeEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+#else
+        // Self-pipe that lets another thread interrupt waitForInput()
+        if (pipe(wakePipe) == 0) {
+            fcntl(wakePipe[0], F_SETFL, fcntl(wakePipe[0], F_GETFL, 0) | O_NONBLOCK);
+            fcntl(wakePipe[1], F_SETFL, fcntl(wakePipe[1], F_GETFL, 0) | O_NONBLOCK);
+        } else {
+            wakePipe[0] = wakePipe[1] = -1;
+        }
+#endif
+    }
+    
+    TerminalController(const TerminalController&) = delete;
+    TerminalController& operator=(const TerminalController&) = delete;
+    
+    /**
+     * @brief Appends an ANSI cursor move (0-based row/col) to a frame buffer.
+     */
+    static void appendCursorMove(string& out, int row, int col) {
+        char digits[16];
+        out += "\033[";
+        out.append(digits, to_chars(digits, digits + sizeof(digits), row + 1).ptr);
+        out += ';';
+        out.append(digits, to_chars(digits, digits + sizeof(digits), col + 1).ptr);
+        out += 'H';
+    }
+
+    /**
+     * @brief Turns writeRaw() into a null sink (used for benchmarking).
+     */
+    void setDiscardOutput(bool discard) {
+        discardOutput = discard;
+    }
+
+    /**
+     * @brief Total bytes passed to writeRaw() so far.
+     */
+    uint64_t getBytesWritten() const {
+        return bytesWritten;
+    }
+
+    /**
+     * @brief writeRaw() calls so far that found stdout full (EAGAIN).
+     */
+    uint64_t getOutputStalls() const {
+        return outputStalls;
+    }
+
+    /**
+     * @brief Bytes written that the terminal has not taken yet (TIOCOUTQ).
+     * @return -1 where that cannot be told (Windows, stdout not a tty)
+     */
+    int getPendingOutput() const {
+        if (discardOutput) return 0;
+#ifdef TIOCOUTQ
+        int pending = 0;
+        if (ioctl(STDOUT_FILENO, TIOCOUTQ, &pending) == 0) return pending;
+#endif
+        return -1;
+    }
+
+    /**
+     * @brief Whether ANSI sequences written via writeRaw() are interpreted.
+     */
+    bool supportsVirtualTerminal() const {
+#ifdef _WIN32
+        return virtualTerminal;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Writes a prepared frame to the terminal in one system call.
+     * 
+     * Anything pending in cout is flushed first to keep output ordered.
+     * On POSIX stdout may share stdin's O_NONBLOCK flag, so EAGAIN waits
+     * for the terminal to drain instead of dropping bytes (and is counted
+     * as a stall, see FramePacer).
+     * @param data Bytes to write
+     * @param size Number of bytes
+     */
+    void writeRaw(const char* data, size_t size) {
+        bytesWritten += size;
+        if (size == 0 || discardOutput) return;
+        cout.flush();
+#ifdef _WIN32
+        if (canvas.isOpen()) {
+            canvas.write(data, size);
+            return;
+        }
+        DWORD written = 0;
+        WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), data, static_cast<DWORD>(size), &written, nullptr);
+#else
+        bool stalled = false;
+        while (size > 0) {
+            ssize_t written = write(STDOUT_FILENO, data, size);
+            if (written > 0) {
+                data += written;
+                size -= static_cast<size_t>(written);
+            } else if (written < 0 && errno == EAGAIN) {
+                if (!stalled) {
+                    stalled = true;
+                    outputStalls++;
+                    SNAKE_PROFILE_COUNT(COUNTER_OUTPUT_STALLS, 1);
+                }
+                pollfd pfd = {STDOUT_FILENO, POLLOUT, 0};
+                poll(&pfd, 1, -1);
+            } else if (written < 0 && errno != EINTR) {
+                return;
+            }
+        }
+#endif
+    }
+
+    /**
+     * @brief Shows everything written since the last present().
+     * 
+     * A no-op except on the Windows console canvas, where it swaps in the
+     * composed frame; other terminals show output as it is written.
+     */
+    void present() {
+#ifdef _WIN32
+        if (!discardOutput) canvas.present();
+#endif
+    }
+
+    /**
+     * @brief Gets the visible size of the terminal window in character cells.
+     * @return False if stdout is not a terminal or output is discarded
+     */
+    bool getWindowSize(int& rows, int& cols) const {
+        if (discardOutput) return false;
+#ifdef _WIN32
+        CONSOLE_SCREEN_BUFFER_INFO info;
+        if (!GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &info)) return false;
+        rows = info.srWindow.Bottom - info.srWindow.Top + 1;
+        cols = info.srWindow.Right - info.srWindow.Left + 1;
+#else
+        winsize size = {};
+        if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_row == 0 || size.ws_col == 0) {
+            return false;
+        }
+        rows = size.ws_row;
+        cols = size.ws_col;
+#endif
+        return true;
+    }
+
+    void clearScreen() {
+#ifdef _WIN32
+        if (discardOutput) return;
+        if (canvas.isOpen()) {
+            canvas.clear();
+        } else if (virtualTerminal) {
+            writeRaw("\033[H\033[J", 6);
+        } else {
+            // Blank the buffer in place rather than spawning `cls`
+            HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+            CONSOLE_SCREEN_BUFFER_INFO info;
+            if (!GetConsoleScreenBufferInfo(output, &info)) return;
+            DWORD cellCount = static_cast<DWORD>(info.dwSize.X) * info.dwSize.Y;
+            DWORD written = 0;
+            cout.flush();
+            FillConsoleOutputCharacterA(output, ' ', cellCount, COORD{0, 0}, &written);
+            FillConsoleOutputAttribute(output, info.wAttributes, cellCount, COORD{0, 0}, &written);
+            SetConsoleCursorPosition(output, COORD{0, 0});
+        }
+#else
+        cout << "\033[H\033[J";
+        cout.flush();
+        this_thread::sleep_for(chrono::milliseconds(10));
+#endif
+    }
+    
+    void setCursorPosition(int row, int col) {
+#ifdef _WIN32
+        if (canvas.isOpen()) {
+            canvas.moveTo(row, col);
+            return;
+        }
+        COORD pos = {(SHORT)col, (SHORT)row};
+        cout.flush();
+        SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), pos);
+#else
+        cout << "\033[" << (row + 1) << ";" << (col + 1) << "H";
+        cout.flush();
+#endif
+    }
+    
+    void hideCursor() {
+        cursorHidden = true;
+#ifdef _WIN32
+        canvas.setCursorVisible(false);
+        HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+        CONSOLE_CURSOR_INFO info;
+        info.dwSize = 100;
+        info.bVisible = FALSE;
+        SetConsoleCursorInfo(consoleHandle, &info);
+#else
+        cout << "\033[?25l";
+        cout.flush();
+#endif
+    }
+    
+    void showCursor() {
+        cursorHidden = false;
+#ifdef _WIN32
+        canvas.setCursorVisible(true);
+        HANDLE consoleHandle = GetStdHandle(STD_OUTPUT_HANDLE);
+        CONSOLE_CURSOR_INFO info;
+        info.dwSize = 100;
+        info.bVisible = TRUE;
+        SetConsoleCursorInfo(consoleHandle, &info);
+#else
+        cout << "\033[?25h";
+        cout.flush();
+#endif
+    }
+    
+    void enableRawMode() {
+#ifdef _WIN32
+        HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+        if (GetConsoleMode(output, &originalOutputMode)) {
+            outputModeChanged = true;
+            virtualTerminal = SetConsoleMode(output, originalOutputMode | ENABLE_VIRTUAL_TERMINAL_PROCESSING) != 0;
+            // Consoles without VT sequences draw through the double-buffered canvas
+            if (!virtualTerminal) canvas.open();
+        }
+#else
+        tcgetattr(STDIN_FILENO, &originalSettings);
+        settingsChanged = true;
+        
+        termios raw = originalSettings;
+        raw.c_lflag &= ~(ECHO | ICANON);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+        
+        originalFlags = fcntl(STDIN_FILENO, F_GETFL, 0);
+        fcntl(STDIN_FILENO, F_SETFL, originalFlags | O_NONBLOCK);
+#endif
+    }
+    
+    void disableRawMode() {
+#ifdef _WIN32
+        canvas.close();
+        if (outputModeChanged) {
+            SetConsoleMode(GetStdHandle(STD_OUTPUT_HANDLE), originalOutputMode);
+            outputModeChanged = false;
+            virtualTerminal = false;
+        }
+#else
+        if (settingsChanged) {
+            tcsetattr(STDIN_FILENO, TCSAFLUSH, &originalSettings);
+            fcntl(STDIN_FILENO, F_SETFL, originalFlags);
+            settingsChanged = false;
+        }
+#endif
+    }
+    
+    bool kbhit() {
+#ifdef _WIN32
+        return _kbhit() != 0;
+#else
+        int bytesWaiting = 0;
+        if (ioctl(STDIN_FILENO, FIONREAD, &bytesWaiting) < 0) return false;
+        return bytesWaiting > 0;
+#endif
+    }
+    
+    char getch() {
+#ifdef _WIN32
+        return _getch();
+#else
+        char c = 0;
+        read(STDIN_FILENO, &c, 1);
+        return c;
+#endif
+    }
+    
+    /**
+     * @brief Blocks until a key is available, the timeout expires, or
+     * wakeInputWait() is called.
+     * 
+     * Sleeps in poll() (WaitForMultipleObjects on Windows), so the process
+     * uses no CPU while waiting. Once stdin reaches end-of-file only the
+     * wakeup is watched and isInputClosed() turns true; an unbounded wait
+     * then returns immediately.
+     * @param timeoutMs Milliseconds to wait; negative waits forever
+     * @return True if kbhit() will report a key
+     */
+    bool waitForInput(int timeoutMs) {
+        if (!inputClosed && kbhit()) return true;
+        
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(max(timeoutMs, 0));
+        while (true) {
+            if (inputClosed && timeoutMs < 0) return false;
+            
+            int remaining = timeoutMs;
+            if (timeoutMs >= 0) {
+                auto left = chrono::ceil<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+                remaining = static_cast<int>(max<int64_t>(left.count(), 0));
+            }
+#ifdef _WIN32
+            HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+            HANDLE handles[2] = {wakeEvent, input};
+            DWORD handleCount = inputClosed ? 1 : 2;
+            DWORD waited = WaitForMultipleObjects(handleCount, handles, FALSE,
+                                                  remaining < 0 ? INFINITE : static_cast<DWORD>(remaining));
+            if (waited == WAIT_TIMEOUT || waited == WAIT_OBJECT_0) return false;
+            if (waited != WAIT_OBJECT_0 + 1) {
+                inputClosed = true;
+                continue;
+            }
+            if (_kbhit()) return true;
+            // Signalled by a non-character event (key release, focus, mouse)
+            FlushConsoleInputBuffer(input);
+#else
+            pollfd fds[2] = {{wakePipe[0], POLLIN, 0}, {inputClosed ? -1 : STDIN_FILENO, POLLIN, 0}};
+            int ready = poll(fds, 2, remaining);
+            if (ready == 0) return false;
+            if (ready < 0) {
+                if (errno == EINTR) continue;
+                inputClosed = true;
+                continue;
+            }
+            if (fds[0].revents & POLLIN) {
+                char drained[64];
+                while (read(wakePipe[0], drained, sizeof(drained)) > 0) {}
+                return false;
+            }
+            if (kbhit()) return true;
+            // Readable with nothing to read: end-of-file or hang-up
+            inputClosed = true;
+#endif
+        }
+    }
+    
+    /**
+     * @brief Interrupts a waitForInput() running on another thread.
+     * 
+     * Safe to call from any thread. A wakeup sent while nobody is waiting
+     * makes the next wait return at once.
+     */
+    void wakeInputWait() {
+#ifdef _WIN32
+        SetEvent(wakeEvent);
+#else
+        char signal = 1;
+        ssize_t sent = write(wakePipe[1], &signal, 1);
+        (void)sent;  // A full pipe already holds a pending wakeup
+#endif
+    }
+    
+    /**
+     * @brief Discards a wakeup nobody consumed.
+     */
+    void clearInputWakeup() {
+#ifdef _WIN32
+        ResetEvent(wakeEvent);
+#else
+        char drained[64];
+        while (read(wakePipe[0], drained, sizeof(drained)) > 0) {}
+#endif
+    }
+    
+    /**
+     * @brief waitForInput() against an absolute deadline, so waking early
+     * for a key never shifts the next tick.
+     */
+    bool waitForInputUntil(chrono::steady_clock::time_point deadline) {
+        auto left = chrono::ceil<chrono::milliseconds>(deadline - chrono::steady_clock::now());
+        return waitForInput(static_cast<int>(max<int64_t>(left.count(), 0)));
+    }
+    
+    /**
+     * @brief Whether stdin has reached end-of-file (no key will ever arrive).
+     */
+    bool isInputClosed() const {
+        return inputClosed;
+    }
+    
+    ~TerminalController() {
+        disableRawMode();
+        if (cursorHidden) {
+            showCursor();
+        }
+#ifdef _WIN32
+        if (wakeEvent) CloseHandle(wakeEvent);
+#else
+        if (wakePipe[0] >= 0) {
+            close(wakePipe[0]);
+            close(wakePipe[1]);
+        }
+#endif
+    }
+};
+
+// ============================================
+// Game Renderer with Config Support
+// ============================================
+
+/**
+ * @brief Chooses the part of the board that is on screen, following the head.
+ * 
+ * The window stays put while the head is inside its middle half and
+ * recenters on the head once it leaves, so the screen scrolls in jumps
+ * instead of redrawing every cell on every tick.
+ */
+class ViewportCamera {
+private:
+    int row = 0;
+    int col = 0;
+    int rows = 0;
+    int cols = 0;
+    
+    static int followAxis(int head, int origin, int size, int limit) {
+        int margin = size / 4;
+        if (head < origin + margin || head >= origin + size - margin) {
+            origin = head - size / 2;
+        }
+        return clamp(origin, 0, max(limit - size, 0));
+    }
+    
+public:
+    /**
+     * @brief Sizes the window and centers it on the head.
+     */
+    void reset(int viewRows, int viewCols, int headRow, int headCol, int boardRows, int boardCols) {
+        rows = viewRows;
+        cols = viewCols;
+        row = clamp(headRow - rows / 2, 0, max(boardRows - rows, 0));
+        col = clamp(headCol - cols / 2, 0, max(boardCols - cols, 0));
+    }
+    
+    /**
+     * @brief Moves the window if the head has left its middle.
+     * @return True if the window moved
+     */
+    bool follow(int headRow, int headCol, int boardRows, int boardCols) {
+        int newRow = followAxis(headRow, row, rows, boardRows);
+        int newCol = followAxis(headCol, col, cols, boardCols);
+        bool moved = newRow != row || newCol != col;
+        row = newRow;
+        col = newCol;
+        return moved;
+    }
+    
+    int getRow() const { return row; }
+    int getCol() const { return col; }
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+};
+
+class GameRenderer {
+private:
+    TerminalController& terminal;
+    HighScoreManager& highScoreManager;
+    const GameConfig& config;
+    int headerRows;
+    int footerRows;
+    
+    // Board window on screen, sized to the terminal in drawFullScreen()
+    ViewportCamera camera;
+    bool viewportMoved;
+    
+    // What is currently on screen, so each frame only emits changed cells
+    vector<char> shownCells;
+    string shownScoreLine;
+    string shownStatsLine;
+    chrono::steady_clock::time_point lastStatsUpdate;
+    string frameBuffer;
+    int cursorRow;
+    int cursorCol;
+    
+    char glyphFor(int cell, bool head) const {
+        switch (cell) {
+            case EMPTY: return config.emptyChar;
+            case SNAKE: return head ? config.snakeHeadChar : config.snakeBodyChar;
+            case FOOD:  return config.foodChar;
+            case WALL:  return config.wallChar;
+            default:    return config.emptyChar;
+        }
+    }
+    
+    /**
+     * @brief Fits the board window to the terminal, leaving room for the
+     * header, borders, controls and stats lines (whatever the snapshot
+     * holds if the terminal size is unknown).
+     */
+    void sizeViewport(const GameState& state) {
+        int viewRows = state.rows;
+        int viewCols = state.cols;
+        int terminalRows = 0;
+        int terminalCols = 0;
+        if (terminal.getWindowSize(terminalRows, terminalCols)) {
+            viewRows = clamp(terminalRows - headerRows - footerRows - 2, 1, max(state.boardRows, 1));
+            viewCols = clamp(terminalCols - 2, 1, max(state.boardCols, 1));
+        }
+        int headRow = state.snakeHead >= 0 ? state.snakeHead / max(state.boardCols, 1) : state.boardRows / 2;
+        int headCol = state.snakeHead >= 0 ? state.snakeHead % max(state.boardCols, 1) : state.boardCols / 2;
+        camera.reset(viewRows, viewCols, headRow, headCol, state.boardRows, state.boardCols);
+        viewportMoved = true;
+    }
+    
+    void moveCursor(int row, int col) {
+        if (row == cursorRow && col == cursorCol) return;
+        
+        if (terminal.supportsVirtualTerminal()) {
+            TerminalController::appendCursorMove(frameBuffer, row, col);
+        } else {
+            flushFrame();
+            terminal.setCursorPosition(row, col);
+        }
+        cursorRow = row;
+        cursorCol = col;
+    }
+    
+    void emit(const char* text, size_t size) {
+        frameBuffer.append(text, size);
+        cursorCol += static_cast<int>(size);
+    }
+    
+    void flushFrame() {
+        SNAKE_PROFILE_COUNT(COUNTER_FRAME_BYTES, frameBuffer.size());
+        terminal.writeRaw(frameBuffer.data(), frameBuffer.size());
+        frameBuffer.clear();
+    }
+    
+public:
+    GameRenderer(TerminalController& term, HighScoreManager& hsm, const GameConfig& cfg) 
+        : terminal(term), highScoreManager(hsm), config(cfg),
+          headerRows(6), footerRows(2), viewportMoved(false), cursorRow(-1), cursorCol(-1) {}
+    
+    int getViewRows() const { return camera.getRows(); }
+    int getViewCols() const { return camera.getCols(); }
+    
+    template<typename Game>
+    void drawFullScreen(const Game& game, bool showInstructions = false) {
+        const GameState& state = game.getGameState();
+        sizeViewport(state);
+        int viewRows = camera.getRows();
+        int viewCols = camera.getCols();
+        
+        ostringstream buffer;
+        
+        // Title
+        buffer << "\n";
+        buffer << "  +===============================+\n";
+        buffer << "  |       SNAKE GAME              |\n";
+        buffer << "  +===============================+\n\n";
+        
+        // Game board
+        buffer << "+";
+        for (int i = 0; i < viewCols; i++) buffer << "-";
+        buffer << "+\n";
+        
+        for (int r = 0; r < viewRows; r++) {
+            buffer << "|";
+            for (int c = 0; c < viewCols; c++) {
+                buffer << " ";
+            }
+            buffer << "|\n";
+        }
+        
+        buffer << "+";
+        for (int i = 0; i < viewCols; i++) buffer << "-";
+        buffer << "+\n";
+        
+        // Controls section
+        buffer << "\n";
+        if (showInstructions) {
+            buffer << "  +===================================+\n";
+            buffer << "  |  CONTROLS:                        |\n";
+            buffer << "  |                                   |\n";
+            buffer << "  |  W or UP Arrow    - Move UP       |\n";
+            buffer << "  |  S or DOWN Arrow  - Move DOWN     |\n";
+            buffer << "  |  A or LEFT Arrow  - Move LEFT     |\n";
+            buffer << "  |  D or RIGHT Arrow - Move RIGHT    |\n";
+            buffer << "  |  Q                - Quit Game     |\n";
+            buffer << "  |                                   |\n";
+            buffer << "  |  Press ENTER to start...          |\n";
+            buffer << "  +===================================+\n";
+        } else {
+            buffer << "  Controls: Arrow Keys or WASD  |  Q: Quit\n";
+        }
+        
+        terminal.clearScreen();
+        terminal.hideCursor();
+        string screen = buffer.str();
+        terminal.writeRaw(screen.data(), screen.size());
+        
+        // Output the score after the static board
+        terminal.setCursorPosition(4, 0);
+        ostringstream scoreBuffer;
+        scoreBuffer << "  Score: " << setw(4) << state.score 
+                    << "  |  Length: " << setw(3) << state.snakeLength 
+                    << "  |  High Score: " << setw(4) << highScoreManager.getHighScore();
+        scoreBuffer << "  ";
+        
+        // The board area was just drawn blank
+        shownCells.assign(static_cast<size_t>(viewRows) * viewCols, ' ');
+        shownScoreLine = scoreBuffer.str();
+        shownStatsLine.clear();
+        terminal.writeRaw(shownScoreLine.data(), shownScoreLine.size());
+        terminal.present();
+    }
+    
+    /**
+     * Diffs the new state against what is on screen and writes only the
+     * changed cells, assembled into one buffer and flushed with one write.
+     * Only the cells inside the camera window are read, so the cost
+     * follows the terminal size rather than the board size.
+     */
+    template<typename Game>
+    void updateGameBoard(const Game& game) {
+        SNAKE_PROFILE_SCOPE(PHASE_RENDER);
+        const GameState& state = game.getGameState();
+        if (camera.getRows() == 0) sizeViewport(state);
+        int viewRows = camera.getRows();
+        int viewCols = camera.getCols();
+        size_t cellCount = static_cast<size_t>(viewRows) * viewCols;
+        if (shownCells.size() != cellCount) {
+            shownCells.assign(cellCount, ' ');
+        }
+        
+        if (state.snakeHead >= 0 && state.boardCols > 0) {
+            viewportMoved |= camera.follow(state.snakeHead / state.boardCols, state.snakeHead % state.boardCols,
+                                           state.boardRows, state.boardCols);
+        }
+        // A sparse snapshot holds the window requested a frame ago; keep to it
+        int top = camera.getRow();
+        int left = camera.getCol();
+        if (state.rows >= viewRows && state.cols >= viewCols) {
+            top = clamp(top, state.originRow, state.originRow + state.rows - viewRows);
+            left = clamp(left, state.originCol, state.originCol + state.cols - viewCols);
+        }
+        
+        frameBuffer.clear();
+        cursorRow = -1;
+        cursorCol = -1;
+        
+        // Score line
+        char scoreLine[96];
+        int scoreLength = snprintf(scoreLine, sizeof(scoreLine),
+                                   "  Score: %4d  |  Length: %3d  |  High Score: %4d  ",
+                                   state.score, state.snakeLength, highScoreManager.getHighScore());
+        if (shownScoreLine.compare(0, string::npos, scoreLine, scoreLength) != 0) {
+            moveCursor(4, 0);
+            emit(scoreLine, scoreLength);
+            shownScoreLine.assign(scoreLine, scoreLength);
+        }
+        
+        // Changed cells only; adjacent changes share one cursor move
+        int colOffset = left - state.originCol;
+        for (int r = 0; r < viewRows; r++) {
+            int bufferRow = top + r - state.originRow;
+            const uint8_t* row = bufferRow >= 0 && bufferRow < state.rows
+                ? state.board.data() + static_cast<size_t>(bufferRow) * state.stride : nullptr;
+            int rowStart = (top + r) * state.boardCols + left;
+            char* shownRow = shownCells.data() + static_cast<size_t>(r) * viewCols;
+            
+            for (int c = 0; c < viewCols; c++) {
+                int bufferCol = colOffset + c;
+                int cell = row && bufferCol >= 0 && bufferCol < state.cols ? row[bufferCol] : static_cast<int>(EMPTY);
+                char glyph = glyphFor(cell, rowStart + c == state.snakeHead);
+                if (shownRow[c] == glyph) continue;
+                
+                moveCursor(headerRows + r, 1 + c);
+                emit(&glyph, 1);
+                shownRow[c] = glyph;
+            }
+        }
+        
+        flushFrame();
+        terminal.present();
+        SNAKE_PROFILE_COUNT(COUNTER_FRAMES, 1);
+    }
+    
+    /**
+     * Tells the game which window the camera wants, so a sparse board
+     * publishes those cells next; dense boards publish everything anyway.
+     */
+    template<typename Game>
+    void requestViewport(Game& game) {
+        if (!viewportMoved) return;
+        game.setViewport(camera.getRow(), camera.getCol(), camera.getRows(), camera.getCols());
+        viewportMoved = false;
+    }
+    
+    /**
+     * Redraws the profiler stats line under the controls, at most four
+     * times a second so the overlay itself stays out of the measurements.
+     */
+    template<typename Game>
+    void updateStatsLine(const Game&) {
+        auto now = chrono::steady_clock::now();
+        if (!shownStatsLine.empty() && now - lastStatsUpdate < chrono::milliseconds(250)) return;
+        lastStatsUpdate = now;
+        
+        string line = Profiler::instance().report().statsLine();
+        if (line.size() < shownStatsLine.size()) line.append(shownStatsLine.size() - line.size(), ' ');
+        if (line == shownStatsLine) return;
+        
+        frameBuffer.clear();
+        cursorRow = -1;
+        cursorCol = -1;
+        moveCursor(headerRows + camera.getRows() + 3, 0);
+        emit(line.data(), line.size());
+        terminal.writeRaw(frameBuffer.data(), frameBuffer.size());
+        terminal.present();
+        frameBuffer.clear();
+        shownStatsLine = line;
+    }
+    
+    /**
+     * @param rank Leaderboard rank of this run, 0 if it did not place
+     */
+    template<typename Game>
+    void showGameOver(const Game& game, uint32_t rank = 0) {
+        const GameState& state = game.getGameState();
+        
+        ostringstream buffer;
+        buffer << "\n";
+        buffer << "  +===============================+\n";
+        buffer << "  |         GAME OVER!            |\n";
+        buffer << "  |   Final Score: " << setw(4) << state.score << "          |\n";
+        buffer << "  |   High Score:  " << setw(4) << highScoreManager.getHighScore() << "          |\n";
+        if (rank > 0) {
+            buffer << "  |   Board Rank:  #" << left << setw(3) << rank << right << "          |\n";
+        }
+        
+        if (highScoreManager.isNewHighScore(state.score) && state.score > 0) {
+            buffer << "  |                               |\n";
+            buffer << "  |   *** NEW HIGH SCORE! ***     |\n";
+        }
+        
+        buffer << "  |                               |\n";
+        buffer << "  |   Press R to Replay           |\n";
+        buffer << "  |   Press Q to Quit             |\n";
+        buffer << "  +===============================+\n";
+        
+        int messageRow = headerRows + camera.getRows() + 3;
+        terminal.setCursorPosition(messageRow, 0);
+        string message = buffer.str();
+        terminal.writeRaw(message.data(), message.size());
+        terminal.present();
+    }
+};
+
+// ============================================
+// Input Handler
+// ============================================
+
+template<typename Game>
+class InputHandler {
+private:
+    TerminalController& terminal;
+    Game& game;
+    char buffer[3];
+    int bufferPos = 0;
+    bool directionKeys = true;
+    
+    void pressDirection(Direction direction) {
+        if (directionKeys) game.setDirection(direction);
+    }
+    
+public:
+    InputHandler(TerminalController& term, Game& g) 
+        : terminal(term), game(g) {
+        memset(buffer, 0, sizeof(buffer));
+    }
+    
+    /**
+     * @brief Turns direction keys on or off; they are still read and discarded.
+     *
+     * Off while the autopilot steers, which sets the direction itself on the
+     * logic thread.
+     */
+    void setDirectionKeys(bool enabled) {
+        directionKeys = enabled;
+    }
+    
+    char getKey() {
+        if (!terminal.kbhit()) return 0;
+        return terminal.getch();
+    }
+    
+    char pollInput() {
+        char key = getKey();
+        if (key == 0) return 0;
+        
+#ifdef _WIN32
+        if (key == -32 || key == 0) {
+            key = terminal.getch();
+            switch(key) {
+                case 72: pressDirection(Game::getDirectionUp()); break;
+                case 80: pressDirection(Game::getDirectionDown()); break;
+                case 75: pressDirection(Game::getDirectionLeft()); break;
+                case 77: pressDirection(Game::getDirectionRight()); break;
+            }
+            return 0;
+        }
+#else
+        if (key == 27) {
+            buffer[0] = key;
+            bufferPos = 1;
+            
+            // The rest of an arrow key sequence arrives together; a lone ESC times out
+            auto deadline = chrono::steady_clock::now() + chrono::milliseconds(20);
+            while (bufferPos < 3 && terminal.waitForInputUntil(deadline)) {
+                buffer[bufferPos++] = terminal.getch();
+            }
+            
+            if (bufferPos >= 3 && buffer[0] == 27 && buffer[1] == '[') {
+                switch(buffer[2]) {
+                    case 'A': pressDirection(Game::getDirectionUp()); break;
+                    case 'B': pressDirection(Game::getDirectionDown()); break;
+                    case 'C': pressDirection(Game::getDirectionRight()); break;
+                    case 'D': pressDirection(Game::getDirectionLeft()); break;
+                }
+            }
+            
+            memset(buffer, 0, sizeof(buffer));
+            bufferPos = 0;
+            return 0;
+        }
+#endif
+        
+        switch(key) {
+            case 'w': case 'W':
+                pressDirection(Game::getDirectionUp());
+                return 0;
+            case 's': case 'S':
+                pressDirection(Game::getDirectionDown());
+                return 0;
+            case 'a': case 'A':
+                pressDirection(Game::getDirectionLeft());
+                return 0;
+            case 'd': case 'D':
+                pressDirection(Game::getDirectionRight());
+                return 0;
+            case 'q': case 'Q':
+                return 'Q';
+            default:
+                return 0;
+        }
+    }
+    
+    void clearBuffer() {
+        while (terminal.kbhit()) {
+            terminal.getch();
+        }
+        memset(buffer, 0, sizeof(buffer));
+        bufferPos = 0;
+    }
+};
+
+// ============================================
+// Fixed-Timestep Scheduler
+// ============================================
+
+/**
+ * @brief Absolute-deadline tick schedule.
+ * 
+ * Deadlines advance by exactly one period per tick, so time spent running
+ * a tick or waking late never accumulates as drift. After a stall the
+ * missed ticks are run back to back, up to a cap; anything beyond the cap
+ * is dropped and the schedule restarts from the present.
+ */
+class FixedTimestepScheduler {
+private:
+    chrono::steady_clock::duration period;
+    int maxCatchUp;
+    chrono::steady_clock::time_point nextTick;
+    
+public:
+    FixedTimestepScheduler(chrono::steady_clock::duration tickPeriod, int maxCatchUpTicks)
+        : period(tickPeriod), maxCatchUp(max(maxCatchUpTicks, 1)) {}
+    
+    /**
+     * @brief Schedules the first tick one period after `now`.
+     */
+    void start(chrono::steady_clock::time_point now) {
+        nextTick = now + period;
+    }
+    
+    chrono::steady_clock::time_point getNextDeadline() const {
+        return nextTick;
+    }
+    
+    /**
+     * @brief Claims the ticks whose deadlines have passed.
+     * @param now Current time
+     * @return Number of ticks to run now, at most the catch-up cap
+     */
+    int collectDueTicks(chrono::steady_clock::time_point now) {
+        if (now < nextTick) return 0;
+        
+        int64_t due = (now - nextTick) / period + 1;
+        if (due > maxCatchUp) {
+            nextTick = now + period;
+            return maxCatchUp;
+        }
+        nextTick += period * due;
+        return static_cast<int>(due);
+    }
+};
+
+// ============================================
+// Frame Pacer
+// ============================================
+
+/**
+ * @brief Spaces terminal frames to what the output can absorb.
+ * 
+ * The simulation never waits on the terminal (see GameSession), but a slow
+ * one still lets output queue up, so the screen falls further and further
+ * behind the game. The renderer asks the pacer when the next frame may go
+ * out and then draws whatever state is latest, so states published in the
+ * meantime are skipped rather than queued.
+ * 
+ * Output counts as behind when bytes are still queued in the tty
+ * (TIOCOUTQ; serial and console ttys report it, ptys always read 0), when
+ * a frame took long to write (blocking ptys, Windows consoles), or when a
+ * non-blocking stdout returned EAGAIN. While it is, the gap between frames doubles up to
+ * MAX_BACKOFF; once output keeps up it halves again. Frames are also kept
+ * at least one frame's own cost apart and within the configured rate.
+ */
+class FramePacer {
+public:
+    static constexpr chrono::milliseconds MAX_BACKOFF{250};
+    static constexpr chrono::milliseconds MIN_BACKOFF{1};
+    static constexpr chrono::microseconds SLOW_FRAME{2000};
+    static constexpr int MAX_PENDING_BYTES = 4096;
+    
+private:
+    chrono::steady_clock::duration minInterval;
+    chrono::steady_clock::duration backoff;
+    chrono::steady_clock::duration frameCost;    ///< Smoothed time to build and write a frame
+    chrono::steady_clock::time_point nextFrame;
+    
+public:
+    /**
+     * @param maxFrameRate Frames per second at most; 0 = no fixed cap
+     */
+    explicit FramePacer(int maxFrameRate)
+        : minInterval(maxFrameRate > 0 ? chrono::steady_clock::duration(chrono::seconds(1)) / maxFrameRate
+                                       : chrono::steady_clock::duration::zero()),
+          backoff(chrono::steady_clock::duration::zero()),
+          frameCost(chrono::steady_clock::duration::zero()) {}
+    
+    /**
+     * @brief Whether output left from earlier frames is too much to add another.
+     * @param pendingBytes TerminalController::getPendingOutput(), -1 if unknown
+     */
+    static bool isBackedUp(int pendingBytes) {
+        return pendingBytes > MAX_PENDING_BYTES;
+    }
+    
+    chrono::steady_clock::time_point getNextFrame() const {
+        return nextFrame;
+    }
+    
+    chrono::steady_clock::duration getBackoff() const {
+        return backoff;
+    }
+    
+    /**
+     * @brief Records a drawn frame and schedules the next one.
+     * @param start When the frame was started
+     * @param end When its write returned
+     * @param pendingBytes Output still queued afterwards, -1 if unknown
+     * @param stalled Whether the write found stdout full
+     */
+    void frameWritten(chrono::steady_clock::time_point start, chrono::steady_clock::time_point end,
+                      int pendingBytes, bool stalled) {
+        chrono::steady_clock::duration cost = end - start;
+        frameCost = (frameCost * 3 + cost) / 4;
+        
+        if (stalled || cost > SLOW_FRAME || isBackedUp(pendingBytes)) {
+            chrono::steady_clock::duration doubled = max<chrono::steady_clock::duration>(backoff * 2, MIN_BACKOFF);
+            backoff = min<chrono::steady_clock::duration>(doubled, MAX_BACKOFF);
+        } else {
+            backoff = backoff / 2 < MIN_BACKOFF ? chrono::steady_clock::duration::zero() : backoff / 2;
+        }
+        nextFrame = end + max({minInterval, frameCost, backoff});
+    }
+};
+
+// ============================================
+// Game Session Manager
+// ============================================
+
+/**
+ * @brief One game from start screen to game over.
+ * 
+ * While playing, three threads share the game:
+ * - simulation: runs update() on a FixedTimestepScheduler
+ * - renderer: draws the latest published state whenever a tick lands and
+ *   the FramePacer lets a frame out, skipping the states in between
+ * - caller: blocks on keyboard input and feeds directions in
+ * The renderer only reads published snapshots and directions go through
+ * the lock-free input queue, so slow terminal output never stretches a tick.
+ * Game is a BasicSnakeGameLogic over either board flavour.
+ */
+template<typename Game = SnakeGameLogic>
+class GameSession {
+private:
+    // Listeners every session has, dispatched without virtual calls
+    using SessionListeners = StaticEventDispatcher<HighScoreManager>;
+    
+    Game game;
+    GameConfig config;
+    EventManager eventManager;
+    TerminalController& terminal;
+    HighScoreManager& highScoreManager;
+    Leaderboard* leaderboard;
+    SessionListeners sessionListeners;
+    EventBatch tickEvents;
+    GameRenderer renderer;
+    ReplayRecorder recorder;
+    Autopilot autopilot;
+    int currentUpdateDelay;
+    
+    // Coordination between the input, simulation and render threads
+    mutex scheduleMutex;
+    condition_variable scheduleWake;
+    atomic<bool> stopRequested;
+    atomic<bool> simulationDone;
+    atomic<uint64_t> framesPublished;
+    
+    void runSimulation() {
+        FixedTimestepScheduler scheduler(chrono::milliseconds(currentUpdateDelay), config.maxCatchUpTicks);
+        scheduler.start(chrono::steady_clock::now());
+        bool alive = true;
+        
+        while (alive) {
+            {
+                unique_lock<mutex> lock(scheduleMutex);
+                if (scheduleWake.wait_until(lock, scheduler.getNextDeadline(),
+                                            [this] { return stopRequested.load(); })) {
+                    break;
+                }
+            }
+            
+            int due = scheduler.collectDueTicks(chrono::steady_clock::now());
+            for (int i = 0; i < due && alive; i++) {
+                // The autopilot searches the whole board, which a sparse board cannot afford
+                if constexpr (!Game::BoardType::IS_SPARSE) {
+                    if (config.autopilot != AUTOPILOT_OFF) {
+                        Direction direction = autopilot.decide(game.getSimulation());
+                        if (direction != NONE) game.steer(direction);
+                    }
+                }
+                alive = game.update();
+                recorder.record(game);
+                dispatchTickEvents();
+            }
+            
+            if (due > 0) {
+                framesPublished.fetch_add(1, memory_order_release);
+                framesPublished.notify_one();
+            }
+        }
+        
+        // Set before the last wakeup so the renderer draws the final state
+        simulationDone.store(true, memory_order_release);
+        framesPublished.fetch_add(1, memory_order_release);
+        framesPublished.notify_one();
+        terminal.wakeInputWait();
+    }
+    
+    /**
+     * Derives the last tick's events from its delta and hands them to
+     * every listener in one batch.
+     */
+    void dispatchTickEvents() {
+        if (SessionListeners::isEmpty && !eventManager.hasListeners()) return;
+        
+        tickEvents.collectTick(game.getLastDelta(), game.getSimulation().getScore(),
+                               static_cast<int>(game.getSimulation().getSnake().getLength()));
+        if (tickEvents.empty()) return;
+        
+        sessionListeners.notify(tickEvents);
+        eventManager.notify(tickEvents);
+    }
+    
+    /**
+     * Holds the next frame until the pacer's slot comes and the terminal
+     * has drained what earlier frames queued. Ticks carry on meanwhile.
+     */
+    void waitForOutput(const FramePacer& pacer) {
+        while (!simulationDone.load(memory_order_acquire)) {
+            if (chrono::steady_clock::now() < pacer.getNextFrame()) {
+                this_thread::sleep_until(pacer.getNextFrame());
+            } else if (FramePacer::isBackedUp(terminal.getPendingOutput())) {
+                this_thread::sleep_for(FramePacer::MIN_BACKOFF);
+            } else {
+                return;
+            }
+        }
+    }
+    
+    void runRenderer() {
+        FramePacer pacer(config.maxFrameRate);
+        uint64_t seen = 0;
+        while (true) {
+            framesPublished.wait(seen, memory_order_acquire);
+            waitForOutput(pacer);
+            
+            // Whatever landed while waiting is coalesced into this frame
+            uint64_t latest = framesPublished.load(memory_order_acquire);
+            SNAKE_PROFILE_COUNT(COUNTER_FRAMES_SKIPPED, latest - seen - 1);
+            seen = latest;
+            
+            bool finished = simulationDone.load(memory_order_acquire);
+            auto start = chrono::steady_clock::now();
+            uint64_t stalls = terminal.getOutputStalls();
+            renderer.updateGameBoard(game);
+            renderer.requestViewport(game);
+            if (config.showStats) renderer.updateStatsLine(game);
+            pacer.frameWritten(start, chrono::steady_clock::now(), terminal.getPendingOutput(),
+                               terminal.getOutputStalls() != stalls);
+            if (finished) break;
+        }
+    }
+    
+    void requestStop() {
+        {
+            lock_guard<mutex> lock(scheduleMutex);
+            stopRequested = true;
+        }
+        scheduleWake.notify_one();
+    }
+    
+public:
+    GameSession(TerminalController& term, HighScoreManager& hsm, const GameConfig& cfg,
+                Leaderboard* board = nullptr)
+        : config(cfg), terminal(term), highScoreManager(hsm), leaderboard(board), sessionListeners(hsm),
+          renderer(term, hsm, config), autopilot(cfg.autopilot), currentUpdateDelay(cfg.updateDelay),
+          stopRequested(false), simulationDone(false), framesPublished(0) {
+        
+        // Wire up event system
+        highScoreManager.setEventManager(&eventManager);
+    }
+    
+    void initialize() {
+        game.initializeBoard(
+            config.rows,
+            config.cols,
+            config.startingLength,
+            config.pointsPerFood,
+            Game::getDirectionRight(),
+            config.seed != 0 ? config.seed : SnakeSimulation::makeSeed()
+        );
+        game.setMaxBufferedTurns(static_cast<size_t>(max(config.maxBufferedTurns, 1)));
+        
+        if (!config.recordPath.empty()) {
+            recorder.start(config.recordPath, game, config.startingLength, config.pointsPerFood,
+                           Game::getDirectionRight(), config.updateDelay);
+        }
+    }
+    
+    bool run() {
+        InputHandler input(terminal, game);
+        input.setDirectionKeys(config.autopilot == AUTOPILOT_OFF || Game::BoardType::IS_SPARSE);
+        
+        // Draw initial screen with instructions
+        renderer.drawFullScreen(game, true);
+        
+        // Wait for ENTER key to start
+        bool enterPressed = false;
+        while (!enterPressed) {
+            if (!terminal.waitForInput(-1)) {
+                return false;
+            }
+            char key = terminal.getch();
+            if (key == '\n' || key == '\r') {
+                enterPressed = true;
+            } else if (key == 'q' || key == 'Q') {
+                return false;
+            }
+        }
+        
+        input.clearBuffer();
+        renderer.drawFullScreen(game, false);
+        
+        // Game loop: simulation and rendering run on their own threads
+        terminal.clearInputWakeup();
+        thread simulationThread(&GameSession::runSimulation, this);
+        thread renderThread(&GameSession::runRenderer, this);
+        
+        // Input stays on this thread until the game ends or Q is pressed
+        bool quit = false;
+        while (!quit && !simulationDone.load(memory_order_acquire)) {
+            if (terminal.waitForInput(-1)) {
+                while (terminal.kbhit()) {
+                    if (input.pollInput() == 'Q') {
+                        quit = true;
+                        break;
+                    }
+                }
+            } else if (terminal.isInputClosed()) {
+                break;  // No more keys will come; let the game play out
+            }
+        }
+        
+        if (quit) {
+            requestStop();
+        }
+        simulationThread.join();
+        renderThread.join();
+        terminal.clearInputWakeup();
+        
+        if (quit) {
+            return false;
+        }
+        
+        // Game over
+        recorder.finish(game);
+        int finalScore = game.getGameState().score;
+        highScoreManager.checkAndSaveHighScore(finalScore);
+        
+        uint32_t rank = 0;
+        if (leaderboard && finalScore > 0) {
+            rank = leaderboard->submit(config.rows, config.cols, config.playerName, finalScore);
+        }
+        renderer.showGameOver(game, rank);
+        
+        // Wait for user input
+        while (terminal.waitForInput(-1)) {
+            char key = terminal.getch();
+            if (key == 'r' || key == 'R') {
+                return true;
+            } else if (key == 'q' || key == 'Q') {
+                return false;
+            }
+        }
+        return false;
+    }
+};
+
+// ============================================
+// Main Game Application
+// ============================================
+
+class SnakeGameApp {
+private:
+    TerminalController terminal;
+    HighScoreManager highScoreManager;
+    Leaderboard leaderboard;
+    GameConfig config;
+    
+public:
+    explicit SnakeGameApp(const GameConfig& cfg = GameConfig()) : config(cfg) {
+        if (!config.leaderboardPath.empty()) {
+            leaderboard.open(config.leaderboardPath);
+        }
+    }
+    
+    /**
+     * Prints the leaderboard for the configured board size.
+     * @return 0 on success, 1 if the leaderboard file is unavailable
+     */
+    int printLeaderboard(size_t limit) {
+        if (!leaderboard.isOpen()) {
+            cerr << "Cannot open leaderboard: " << config.leaderboardPath << "\n";
+            return 1;
+        }
+        
+        vector<LeaderboardEntry> entries = leaderboard.top(config.rows, config.cols, limit);
+        cout << "  Leaderboard " << config.rows << "x" << config.cols << "\n";
+        if (entries.empty()) {
+            cout << "  (no scores yet)\n";
+        }
+        for (size_t i = 0; i < entries.size(); i++) {
+            cout << "  " << setw(3) << (i + 1) << ".  " << setw(6) << entries[i].score
+                 << "  " << entries[i].player << "\n";
+        }
+        return 0;
+    }
+    
+    /**
+     * Plays back a replay log. Paced modes render to the terminal (Q stops);
+     * unthrottled mode only reports the outcome.
+     * @return 0 if the replay reproduced its recorded outcome
+     */
+    int runReplay(const string& path, PlaybackMode mode, double speed) {
+        ReplayPlayer player;
+        if (!player.load(path)) {
+            cerr << "Cannot read replay log: " << path << "\n";
+            return 1;
+        }
+        
+        // Replay on the board type the recording was played on (see run()):
+        // a chunked board places food differently from a dense one
+        auto replay = [&](auto board) {
+            using BoardT = typename decltype(board)::type;
+            using Game = BasicSnakeGameLogic<BoardT>;
+            Game game;
+            ReplayResult result;
+            
+            if (mode == PlaybackMode::UNTHROTTLED) {
+                game.setKeyframeInterval(0);
+                auto start = chrono::steady_clock::now();
+                result = player.play(game);
+                double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                cout << "  Replayed " << result.ticks << " ticks in " << fixed << setprecision(3)
+                     << seconds << "s\n";
+            } else {
+                GameConfig replayConfig = config;
+                replayConfig.rows = player.getHeader().rows;
+                replayConfig.cols = player.getHeader().cols;
+                GameRenderer renderer(terminal, highScoreManager, replayConfig);
+                
+                terminal.enableRawMode();
+                player.initialize(game);
+                renderer.drawFullScreen(game, false);
+                renderer.requestViewport(game);
+                // A chunked board publishes only the window the camera asks for
+                result = player.play(game, mode, speed, [&](const Game&) {
+                    renderer.updateGameBoard(game);
+                    renderer.requestViewport(game);
+                    if (terminal.kbhit()) {
+                        char key = terminal.getch();
+                        if (key == 'q' || key == 'Q') return false;
+                    }
+                    return true;
+                });
+                terminal.clearScreen();
+                terminal.showCursor();
+                terminal.disableRawMode();
+            }
+            return result;
+        };
+        
+        int rows = player.getHeader().rows;
+        int cols = player.getHeader().cols;
+        ReplayResult result = ChunkedBoard::isHuge(rows, cols)
+            ? replay(type_identity<ChunkedBoard>{})
+            : visitBoardType(rows, cols, replay);
+        
+        cout << "  Final score: " << result.finalScore << "  |  Ticks: " << result.ticks;
+        if (result.hasTrailer) {
+            cout << "  |  " << (result.matches ? "matches recording" : "DIFFERS from recording");
+        }
+        cout << "\n";
+        return result.matches ? 0 : 2;
+    }
+    
+    void run() {
+        terminal.enableRawMode();
+        
+        // Create game sessions on a fixed-size board when one fits, and on a
+        // chunked board when a dense one would be too large
+        auto play = [&](auto board) {
+            using BoardT = typename decltype(board)::type;
+            GameSession<BasicSnakeGameLogic<BoardT>> session(
+                terminal, highScoreManager, config,
+                leaderboard.isOpen() ? &leaderboard : nullptr);
+            session.initialize();
+            return session.run();
+        };
+        
+        while (true) {
+            bool replay = ChunkedBoard::isHuge(config.rows, config.cols)
+                ? play(type_identity<ChunkedBoard>{})
+                : visitBoardType(config.rows, config.cols, play);
+            if (!replay) {
+                break;
+            }
+        }
+        
+        highScoreManager.flush();
+        terminal.clearScreen();
+        terminal.showCursor();
+        ostringstream exitBuffer;
+        exitBuffer << "\n  Thanks for playing!\n\n";
+        cout << exitBuffer.str();
+        cout.flush();
+    }
+};
+
+#endif // GAMEAPP_H
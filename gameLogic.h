@@ -6,43 +6,23 @@
 #define NOMINMAX
 
 #include <iostream>
-#include <deque>
+#include <cstdint>
+#include <cstring>
+#include <span>
 #include <vector>
+#include <array>
+#include <type_traits>
 #include <random>
 #include <atomic>
 #include <memory>
 #include <chrono>
+#include <algorithm>
 
-using namespace std;
-
-/**
- * @brief Immutable snapshot of the game state at a specific point in time.
- * 
- * This structure is designed to be thread-safe when accessed through
- * shared_ptr with proper memory ordering. All fields are copied from
- * the game logic state during publishing.
- */
-struct GameState {
-    vector<vector<int>> board;      ///< 2D grid representing the game board
-    int rows;                        ///< Number of rows in the board
-    int cols;                        ///< Number of columns in the board
-    int score;                       ///< Current game score
-    bool gameOver;                   ///< Game over flag
-    pair<int, int> food;            ///< Current food position
-    bool foodExists;                 ///< Whether food is present on the board
-    deque<pair<int, int>> snake;    ///< Snake body segments
-    int snakeLength;                 ///< Current length of the snake
-};
-
-// ============================================================================
-// FORWARD DECLARATIONS
-// ============================================================================
+#include "bitboard.h"
+#include "gameRandom.h"
+#include "profiler.h"
 
-class Board;
-class Snake;
-class FoodManager;
-class CollisionDetector;
-class DirectionController;
+using namespace std;
 
 // ============================================================================
 // ENUMERATIONS
@@ -69,6 +49,136 @@ enum CellType {
     WALL = 3 
 };
 
+/**
+ * @brief Why a game ended.
+ */
+enum GameOverCause {
+    NOT_OVER = 0,
+    HIT_WALL = 1,        ///< Left the board or ran into a WALL cell
+    HIT_SELF = 2,        ///< Ran into its own body
+    BOARD_FILLED = 3     ///< Filled every cell (a win)
+};
+
+/**
+ * @brief Incremental change produced by one game tick.
+ * 
+ * A normal tick touches at most three cells, so consumers that already hold
+ * a snapshot can stay current by applying these instead of copying the
+ * whole world. Cell fields are whole-board indices (row * board cols + col),
+ * -1 when unused.
+ */
+struct GameDelta {
+    uint64_t tick;                   ///< Sequence number of the state this delta produces
+    int32_t headAdded;               ///< Cell the head moved into
+    int32_t tailRemoved;             ///< Cell the tail vacated
+    int32_t foodRemoved;             ///< Cell the food was eaten from
+    int32_t foodAdded;               ///< Cell new food was placed on
+    int32_t scoreDelta;              ///< Score gained this tick
+    bool gameOver;                   ///< Whether this tick ended the game
+};
+
+/**
+ * @brief Snapshot of the game state at a specific point in time.
+ * 
+ * StatePublisher keeps three of these and hands the reader one it will not
+ * write to until the reader moves on. All fields are copied from the game
+ * logic state during publishing.
+ *
+ * On a dense board `board` holds every cell. On a sparse board
+ * (ChunkedBoard) it holds only the viewport window starting at
+ * (originRow, originCol); such snapshots are not kept current by deltas
+ * (the window follows the head, which a mirror cannot reproduce), so
+ * sparse games have no delta channel.
+ * Cell indices in `snake`, `snakeHead` and deltas always address the
+ * whole board (row * boardCols + col).
+ */
+struct GameState {
+    vector<uint8_t> board;           ///< Row-major cell buffer, one byte per cell
+    int rows;                        ///< Number of rows in the buffer
+    int cols;                        ///< Number of columns in the buffer
+    int stride;                      ///< Cells between the starts of consecutive rows
+    int originRow;                   ///< Board row of the buffer's first row
+    int originCol;                   ///< Board column of the buffer's first column
+    int boardRows;                   ///< Rows of the whole board
+    int boardCols;                   ///< Columns of the whole board
+    int score;                       ///< Current game score
+    bool gameOver;                   ///< Game over flag
+    pair<int, int> food;            ///< Current food position
+    bool foodExists;                 ///< Whether food is present on the board
+    vector<uint32_t> snake;          ///< Snake body as whole-board cell indices (row * boardCols + col), head first
+    int snakeLength;                 ///< Current length of the snake
+    int32_t snakeHead;               ///< Whole-board cell index of the head, -1 if no snake
+    uint64_t tick;                   ///< Publication sequence number (one per update/initialize)
+
+    /**
+     * @brief Reads a cell from the row-major buffer (no bounds check).
+     */
+    int cellAt(int r, int c) const { return board[r * stride + c]; }
+
+    /**
+     * @brief Reads a cell by board position; EMPTY outside the buffered window.
+     */
+    int boardCellAt(int r, int c) const {
+        r -= originRow;
+        c -= originCol;
+        if (r < 0 || r >= rows || c < 0 || c >= cols) return EMPTY;
+        return board[r * stride + c];
+    }
+
+    /**
+     * @brief Writes a cell given by whole-board index; ignored outside the buffered window.
+     */
+    void setBoardCell(int32_t index, uint8_t cellType) {
+        int r = index / boardCols - originRow;
+        int c = index % boardCols - originCol;
+        if (r < 0 || r >= rows || c < 0 || c >= cols) return;
+        board[r * stride + c] = cellType;
+    }
+
+    /**
+     * @brief Advances this snapshot by one tick.
+     * 
+     * Keeps the board, head, length, food and scalars current. The ordered
+     * `snake` body is only refreshed by full snapshots. Delta indices
+     * address the whole board, so on a windowed snapshot only the cells
+     * inside the window are written.
+     * @param delta Delta whose tick directly follows this state's tick
+     */
+    void applyDelta(const GameDelta& delta) {
+        if (delta.foodRemoved >= 0) {
+            setBoardCell(delta.foodRemoved, EMPTY);
+            foodExists = false;
+        }
+        if (delta.tailRemoved >= 0) {
+            setBoardCell(delta.tailRemoved, EMPTY);
+            snakeLength--;
+        }
+        if (delta.headAdded >= 0) {
+            setBoardCell(delta.headAdded, SNAKE);
+            snakeHead = delta.headAdded;
+            snakeLength++;
+        }
+        if (delta.foodAdded >= 0) {
+            setBoardCell(delta.foodAdded, FOOD);
+            food = {delta.foodAdded / boardCols, delta.foodAdded % boardCols};
+            foodExists = true;
+        }
+        score += delta.scoreDelta;
+        gameOver = gameOver || delta.gameOver;
+        tick = delta.tick;
+    }
+};
+
+// ============================================================================
+// FORWARD DECLARATIONS
+// ============================================================================
+
+template<int Rows, int Cols> class BasicBoard;
+class Snake;
+class FoodManager;
+class CollisionDetector;
+class DirectionController;
+
 // ============================================================================
 // BOARD MANAGEMENT
 // ============================================================================
@@ -79,23 +189,95 @@ enum CellType {
  * Provides a clean interface for board manipulation including cell access,
  * modification, and initialization. This class encapsulates all board-related
  * logic and provides boundary checking.
+ *
+ * Cells live in a single row-major byte buffer so a whole-board copy is one
+ * memcpy; `toIndex()` and the index-based accessors expose that layout.
+ *
+ * Every EMPTY cell index is also kept in a dense free-cell array with a
+ * reverse slot map. Cell writes fix it up by swap-remove, so counting free
+ * cells and picking the k-th one are O(1) and never allocate.
+ *
+ * `BasicBoard<>` (the `Board` alias) takes its size at runtime and keeps its
+ * buffers on the heap. `BasicBoard<Rows, Cols>` fixes the size at compile
+ * time: storage is inline `std::array`s and bounds, strides and neighbor
+ * offsets are constants, so loops over the board can be unrolled and
+ * vectorized.
+ *
+ * Alongside the byte grid the board keeps one bit plane per CellType
+ * (`getOccupancy()`, see bitboard.h). Whole-board questions - how many free
+ * cells, the k-th free cell in row-major order, what the head can still
+ * reach - then cost a pass over 64-cell words instead of a byte scan.
  */
-class Board {
+template<int Rows, int Cols>
+class BasicBoard {
+    static_assert((Rows > 0) == (Cols > 0), "Fix both dimensions or neither");
+
+public:
+    static constexpr bool IS_FIXED = Rows > 0;
+    static constexpr bool IS_SPARSE = false;     ///< Every cell is stored (ChunkedBoard is the sparse board)
+    static constexpr int ROWS = Rows;
+    static constexpr int COLS = Cols;
+    static constexpr size_t CELL_COUNT = static_cast<size_t>(Rows) * Cols;
+
+    /// Index offset of the neighboring cell in each Direction (UP, DOWN, LEFT, RIGHT)
+    static constexpr int NEIGHBOR_OFFSETS[4] = {-Cols, Cols, -1, 1};
+
+    using BitPlaneType = BasicBitPlane<Rows, Cols>;
+
 private:
-    vector<vector<int>> grid;
+    template<typename T>
+    using Storage = conditional_t<IS_FIXED, array<T, CELL_COUNT>, vector<T>>;
+
+    Storage<uint8_t> cells;
+    Storage<int> freeCells;     ///< Dense array of EMPTY cell indices; first freeCount are live
+    Storage<int> freeSlot;      ///< Position of each cell in freeCells, -1 if occupied
+    int freeCount;
     int rows;
     int cols;
+    BitPlaneType planes[4];     ///< Occupancy bits, indexed by CellType
+
+    void addFree(int index) {
+        freeSlot[index] = freeCount;
+        freeCells[freeCount++] = index;
+    }
+
+    void removeFree(int index) {
+        int slot = freeSlot[index];
+        int last = freeCells[--freeCount];
+        freeCells[slot] = last;
+        freeSlot[last] = slot;
+        freeSlot[index] = -1;
+    }
 
 public:
+    BasicBoard() : freeCount(0), rows(Rows), cols(Cols) {}
+
     /**
      * @brief Initializes the board with specified dimensions.
-     * @param rows Number of rows
-     * @param cols Number of columns
+     * @param rows Number of rows (must equal Rows on a fixed board)
+     * @param cols Number of columns (must equal Cols on a fixed board)
      */
     void initialize(int rows, int cols) {
-        this->rows = rows;
-        this->cols = cols;
-        grid = vector<vector<int>>(rows, vector<int>(cols, EMPTY));
+        size_t cellCount = CELL_COUNT;
+        if constexpr (!IS_FIXED) {
+            this->rows = rows;
+            this->cols = cols;
+            cellCount = static_cast<size_t>(rows) * cols;
+            cells.resize(cellCount);
+            freeCells.resize(cellCount);
+            freeSlot.resize(cellCount);
+        }
+        fill(cells.begin(), cells.end(), static_cast<uint8_t>(EMPTY));
+        for (size_t i = 0; i < cellCount; i++) {
+            freeCells[i] = static_cast<int>(i);
+            freeSlot[i] = static_cast<int>(i);
+        }
+        freeCount = static_cast<int>(cellCount);
+        
+        for (BitPlaneType& plane : planes) {
+            plane.initialize(getRows(), getCols());
+        }
+        planes[EMPTY].fillAll();
     }
 
     /**
@@ -105,7 +287,35 @@ public:
      * @return True if position is valid, false otherwise
      */
     bool isInBounds(int r, int c) const {
-        return r >= 0 && r < rows && c >= 0 && c < cols;
+        return r >= 0 && r < getRows() && c >= 0 && c < getCols();
+    }
+
+    /**
+     * @brief Converts a position to its offset in the cell buffer.
+     * @param r Row index
+     * @param c Column index
+     * @return Row-major cell index
+     */
+    int toIndex(int r, int c) const {
+        return r * getStride() + c;
+    }
+
+    /**
+     * @brief Index offset to the neighbor in a direction (0 for NONE).
+     */
+    int neighborOffset(Direction direction) const {
+        if constexpr (IS_FIXED) {
+            return direction == NONE ? 0 : NEIGHBOR_OFFSETS[direction];
+        } else {
+            switch (direction) {
+                case UP:    return -cols;
+                case DOWN:  return cols;
+                case LEFT:  return -1;
+                case RIGHT: return 1;
+                case NONE:  break;
+            }
+            return 0;
+        }
     }
 
     /**
@@ -116,7 +326,16 @@ public:
      */
     int getCellType(int r, int c) const {
         if (!isInBounds(r, c)) return WALL;
-        return grid[r][c];
+        return cells[toIndex(r, c)];
+    }
+
+    /**
+     * @brief Gets the cell type at a buffer index (no bounds check).
+     * @param index Row-major cell index
+     * @return CellType at the index
+     */
+    int getCell(int index) const {
+        return cells[index];
     }
 
     /**
@@ -127,65 +346,243 @@ public:
      */
     void setCellType(int r, int c, int cellType) {
         if (isInBounds(r, c)) {
-            grid[r][c] = cellType;
+            setCell(toIndex(r, c), cellType);
+        }
+    }
+
+    /**
+     * @brief Sets the cell type at a buffer index (no bounds check).
+     * @param index Row-major cell index
+     * @param cellType Type to set
+     */
+    void setCell(int index, int cellType) {
+        int previous = cells[index];
+        if (previous == cellType) return;
+        bool wasEmpty = previous == EMPTY;
+        bool isEmpty = cellType == EMPTY;
+        cells[index] = static_cast<uint8_t>(cellType);
+        int r = index / getStride();
+        int c = index - r * getStride();
+        planes[previous].reset(r, c);
+        planes[cellType].set(r, c);
+        
+        if (wasEmpty && !isEmpty) {
+            removeFree(index);
+        } else if (!wasEmpty && isEmpty) {
+            addFree(index);
         }
     }
 
+    /**
+     * @brief Gets the number of empty cells on the board.
+     * @return Free cell count
+     */
+    int getFreeCellCount() const {
+        return freeCount;
+    }
+
+    /**
+     * @brief Gets the k-th entry of the free-cell set (order is arbitrary).
+     * @param k Index in [0, getFreeCellCount())
+     * @return Row-major index of an empty cell
+     */
+    int getFreeCell(int k) const {
+        return freeCells[k];
+    }
+
+    /**
+     * @brief The free-cell array (first getFreeCellCount() entries live) and
+     * its reverse slot map, for copying the set in its exact order.
+     */
+    span<const int> getFreeCells() const { return {freeCells.data(), static_cast<size_t>(getCellCount())}; }
+    span<const int> getFreeSlots() const { return {freeSlot.data(), static_cast<size_t>(getCellCount())}; }
+
+    /**
+     * @brief Gets the bit plane of all cells holding one CellType.
+     * @param cellType EMPTY, SNAKE, FOOD or WALL
+     */
+    const BitPlaneType& getOccupancy(int cellType) const {
+        return planes[cellType];
+    }
+
+    /**
+     * @brief Gets the k-th empty cell in row-major order.
+     * 
+     * Unlike getFreeCell() the order is stable, at the price of a
+     * popcount pass over the free plane.
+     * @param k Index in [0, getFreeCellCount())
+     * @return Row-major index of an empty cell, -1 if out of range
+     */
+    int selectFreeCell(int k) const {
+        return planes[EMPTY].select(k);
+    }
+
+    /**
+     * @brief Counts the cells reachable from a cell through EMPTY and FOOD cells.
+     * @param from Row-major index to start from (usually the head)
+     * @param reached Receives the reachable set, including `from`
+     * @param scratch Receives the passable plane it was computed over
+     * @return Number of reachable cells, not counting `from`
+     */
+    int countReachable(int from, BitPlaneType& reached, BitPlaneType& scratch) const {
+        scratch.assignOr(planes[EMPTY], planes[FOOD]);
+        return reached.floodFill(from, scratch) - 1;
+    }
+
     /**
      * @brief Gets all empty cell positions on the board.
-     * @return Vector of empty cell coordinates
+     * @return Vector of empty cell coordinates (unordered)
      */
     vector<pair<int, int>> getEmptyCells() const {
         vector<pair<int, int>> emptyCells;
-        for (int r = 0; r < rows; r++) {
-            for (int c = 0; c < cols; c++) {
-                if (grid[r][c] == EMPTY) {
-                    emptyCells.push_back({r, c});
-                }
-            }
+        emptyCells.reserve(freeCount);
+        for (int k = 0; k < freeCount; k++) {
+            emptyCells.push_back({freeCells[k] / getStride(), freeCells[k] % getStride()});
         }
         return emptyCells;
     }
 
-    int getRows() const { return rows; }
-    int getCols() const { return cols; }
-    const vector<vector<int>>& getGrid() const { return grid; }
+    int getRows() const {
+        if constexpr (IS_FIXED) return Rows;
+        else return rows;
+    }
+
+    int getCols() const {
+        if constexpr (IS_FIXED) return Cols;
+        else return cols;
+    }
+
+    int getStride() const { return getCols(); }
+
+    int getCellCount() const {
+        if constexpr (IS_FIXED) return static_cast<int>(CELL_COUNT);
+        else return static_cast<int>(cells.size());
+    }
+
+    const uint8_t* data() const { return cells.data(); }
+    span<const uint8_t> getCells() const { return {cells.data(), static_cast<size_t>(getCellCount())}; }
 };
 
+/// Board sized at runtime
+using Board = BasicBoard<0, 0>;
+
+/// Board sized at compile time
+template<int Rows, int Cols>
+using FixedBoard = BasicBoard<Rows, Cols>;
+
 // ============================================================================
 // SNAKE MANAGEMENT
 // ============================================================================
 
+/**
+ * @brief Read-only view of the snake body, head first.
+ * 
+ * The body lives in a ring buffer, so it is exposed as at most two contiguous
+ * spans of packed cell indices (row * cols + col). Readers can walk or memcpy
+ * them directly instead of copying the body.
+ */
+struct SnakeBodyView {
+    span<const uint32_t> first;      ///< Segments from the head up to the end of the buffer
+    span<const uint32_t> second;     ///< Remaining segments after wrap-around (may be empty)
+
+    size_t size() const { return first.size() + second.size(); }
+
+    uint32_t operator[](size_t i) const {
+        return i < first.size() ? first[i] : second[i - first.size()];
+    }
+};
+
 /**
  * @brief Manages the snake entity including movement, growth, and collision.
  * 
  * Encapsulates all snake-related behavior including body segment tracking,
  * movement mechanics, and growth logic. Provides a clean interface for
  * snake operations.
+ *
+ * Segments are packed 32-bit cell indices in a ring buffer sized once to
+ * rows * cols (the longest possible snake), so moving never allocates. A
+ * compact ring (setCompactRing(), and always on a sparse board) starts
+ * small and doubles as the snake grows.
  */
 class Snake {
 private:
-    deque<pair<int, int>> body;
+    vector<uint32_t> ring;
+    size_t headSlot;
+    size_t length;
+    int cols;
     int growthPending;
+    bool compactRing;
+
+    size_t slotAt(size_t i) const {
+        size_t slot = headSlot + i;
+        return slot >= ring.size() ? slot - ring.size() : slot;
+    }
+
+    pair<int, int> unpack(uint32_t index) const {
+        return {static_cast<int>(index) / cols, static_cast<int>(index) % cols};
+    }
+
+    /**
+     * @brief Ring size for a board: every cell, or for a compact ring (and
+     * on a sparse board, whose full size would not fit) a start that grows
+     * on demand.
+     */
+    template<typename BoardT>
+    size_t ringCapacity(const BoardT& board, size_t length) const {
+        size_t cellCount = static_cast<size_t>(board.getCellCount());
+        if (BoardT::IS_SPARSE || compactRing) {
+            return min(cellCount, max(length * 2, size_t(1024)));
+        }
+        return cellCount;
+    }
+
+    /**
+     * @brief Doubles a compact ring, keeping segment order.
+     */
+    void growRing(size_t cellCount) {
+        vector<uint32_t> grown(min(cellCount, ring.size() * 2));
+        for (size_t i = 0; i < length; i++) {
+            grown[i] = ring[slotAt(i)];
+        }
+        ring.swap(grown);
+        headSlot = 0;
+    }
 
 public:
-    Snake() : growthPending(0) {}
+    Snake() : headSlot(0), length(0), cols(1), growthPending(0), compactRing(false) {}
+
+    /**
+     * @brief Starts the ring small and grows it as the snake grows, for
+     * boards shared by many snakes; takes effect at the next initialize.
+     */
+    void setCompactRing(bool compact) {
+        compactRing = compact;
+    }
 
     /**
      * @brief Initializes the snake at a starting position.
+     * 
+     * Segments that would start outside the board are dropped.
      * @param startPos Initial head position
      * @param length Starting length of the snake
      * @param direction Initial movement direction
      * @param board Reference to the game board
      */
-    void initialize(pair<int, int> startPos, int length, Direction direction, Board& board) {
-        body.clear();
+    template<typename BoardT>
+    void initialize(pair<int, int> startPos, int length, Direction direction, BoardT& board) {
+        size_t capacity = ringCapacity(board, static_cast<size_t>(max(length, 0)));
+        if (ring.size() != capacity) {
+            ring.assign(capacity, 0);
+        }
+        cols = board.getStride();
+        headSlot = 0;
+        this->length = 0;
         growthPending = 0;
         
         int startRow = startPos.first;
         int startCol = startPos.second;
         
-        for (int i = 0; i < length; i++) {
+        for (int i = 0; i < length && this->length < capacity; i++) {
             int r = startRow;
             int c = startCol;
             
@@ -197,27 +594,93 @@ public:
                 case NONE:  break;
             }
             
-            body.push_back({r, c});
+            if (!board.isInBounds(r, c)) break;
+            
+            ring[this->length++] = static_cast<uint32_t>(board.toIndex(r, c));
             board.setCellType(r, c, SNAKE);
         }
     }
 
+    /**
+     * @brief Places the snake along explicit cells, head first.
+     * 
+     * Cells must be distinct, in bounds and adjacent in order.
+     * @param cells Packed cell indices (row * cols + col), head first
+     * @param board Reference to the game board
+     * @param growth Segments still to be grown (non-zero when restoring a game)
+     */
+    template<typename BoardT>
+    void initializePath(span<const uint32_t> cells, BoardT& board, int growth = 0) {
+        size_t capacity = ringCapacity(board, cells.size() + static_cast<size_t>(max(growth, 0)));
+        if (ring.size() != capacity) {
+            ring.assign(capacity, 0);
+        }
+        cols = board.getStride();
+        headSlot = 0;
+        length = min(cells.size(), capacity);
+        growthPending = growth;
+        
+        for (size_t i = 0; i < length; i++) {
+            ring[i] = cells[i];
+            board.setCell(static_cast<int>(cells[i]), SNAKE);
+        }
+    }
+
     /**
      * @brief Moves the snake to a new head position.
      * @param newHead New head position
      * @param board Reference to the game board
      */
-    void move(pair<int, int> newHead, Board& board) {
-        body.push_front(newHead);
-        board.setCellType(newHead.first, newHead.second, SNAKE);
-        
+    template<typename BoardT>
+    void move(pair<int, int> newHead, BoardT& board) {
+        // Release the tail first so a head entering the vacated cell keeps it
+        releaseTail(board);
+        pushHead(board.toIndex(newHead.first, newHead.second), board);
+    }
+
+    /**
+     * @brief First half of move(): uses up one pending growth, or frees the tail cell.
+     * 
+     * Boards shared by several snakes release every tail before pushing
+     * any head, so a head may follow another snake's tail.
+     * @param board Reference to the game board
+     */
+    template<typename BoardT>
+    void releaseTail(BoardT& board) {
         if (growthPending > 0) {
+            // Only a compact ring can be full here; a board-sized one has room for every cell
+            if (length == ring.size()) growRing(static_cast<size_t>(board.getCellCount()));
             growthPending--;
         } else {
-            pair<int, int> tail = body.back();
-            body.pop_back();
-            board.setCellType(tail.first, tail.second, EMPTY);
+            board.setCell(static_cast<int>(ring[slotAt(length - 1)]), EMPTY);
+            length--;
+        }
+    }
+
+    /**
+     * @brief Second half of move(): the head enters a cell.
+     * @param headIndex Row-major index of the new head cell
+     * @param board Reference to the game board
+     */
+    template<typename BoardT>
+    void pushHead(int headIndex, BoardT& board) {
+        headSlot = headSlot == 0 ? ring.size() - 1 : headSlot - 1;
+        ring[headSlot] = static_cast<uint32_t>(headIndex);
+        length++;
+        board.setCell(headIndex, SNAKE);
+    }
+
+    /**
+     * @brief Takes the whole snake off the board.
+     * @param board Reference to the game board
+     */
+    template<typename BoardT>
+    void removeFrom(BoardT& board) {
+        for (size_t i = 0; i < length; i++) {
+            board.setCell(static_cast<int>(ring[slotAt(i)]), EMPTY);
         }
+        length = 0;
+        growthPending = 0;
     }
 
     /**
@@ -229,21 +692,42 @@ public:
     }
 
     /**
-     * @brief Checks if a position collides with the snake body.
+     * @brief Checks if moving the head to a position collides with the body.
+     * 
+     * Uses the board's SNAKE occupancy, so the cost does not depend on length.
+     * The tail cell is safe when the snake is not growing, because the tail
+     * leaves it on the same tick the head arrives.
      * @param pos Position to check
+     * @param board Reference to the game board
      * @return True if collision detected, false otherwise
      */
-    bool checkSelfCollision(pair<int, int> pos) const {
-        for (size_t i = 1; i < body.size(); i++) {
-            if (body[i] == pos) return true;
-        }
-        return false;
+    template<typename BoardT>
+    bool checkSelfCollision(pair<int, int> pos, const BoardT& board) const {
+        if (board.getCellType(pos.first, pos.second) != SNAKE) return false;
+        uint32_t index = static_cast<uint32_t>(board.toIndex(pos.first, pos.second));
+        if (index == getHeadIndex()) return false;
+        return growthPending > 0 || index != getTailIndex();
+    }
+
+    /**
+     * @brief Gets the body as up to two contiguous spans, head first.
+     * @return View into the ring buffer (invalidated by the next move)
+     */
+    SnakeBodyView getBody() const {
+        size_t firstSize = min(length, ring.size() - headSlot);
+        return {
+            span<const uint32_t>(ring.data() + headSlot, firstSize),
+            span<const uint32_t>(ring.data(), length - firstSize)
+        };
     }
 
-    pair<int, int> getHead() const { return body.front(); }
-    const deque<pair<int, int>>& getBody() const { return body; }
-    size_t getLength() const { return body.size(); }
+    pair<int, int> getHead() const { return unpack(getHeadIndex()); }
+    pair<int, int> getTail() const { return unpack(getTailIndex()); }
+    uint32_t getHeadIndex() const { return ring[headSlot]; }
+    uint32_t getTailIndex() const { return ring[slotAt(length - 1)]; }
+    size_t getLength() const { return length; }
     bool hasPendingGrowth() const { return growthPending > 0; }
+    int getPendingGrowth() const { return growthPending; }
 };
 
 // ============================================================================
@@ -252,39 +736,57 @@ public:
 
 /**
  * @brief Manages food placement and state on the game board.
- * 
+ *
  * Handles random food placement ensuring food appears only on empty cells.
- * Uses a random number generator for unpredictable food positions.
+ * The random policy is passed to placeRandom(), so one manager works with
+ * any engine.
  */
 class FoodManager {
 private:
     pair<int, int> position;
     bool exists;
-    mt19937& rng;
 
 public:
-    /**
-     * @brief Constructs a food manager with a random number generator.
-     * @param rng Reference to random number generator
-     */
-    FoodManager(mt19937& rng) : exists(false), rng(rng) {}
+    FoodManager() : exists(false) {}
 
     /**
      * @brief Places food at a random empty location on the board.
      * @param board Reference to the game board
+     * @param rng Random policy to draw from (a BasicGameRandom)
      */
-    void placeRandom(Board& board) {
-        vector<pair<int, int>> emptyCells = board.getEmptyCells();
+    template<typename BoardT, typename RandomT>
+    void placeRandom(BoardT& board, RandomT& rng) {
+        int freeCount = board.getFreeCellCount();
         
-        if (emptyCells.empty()) {
+        if (freeCount == 0) {
             exists = false;
             return;
         }
         
-        uniform_int_distribution<int> dist(0, emptyCells.size() - 1);
-        int idx = dist(rng);
-        position = emptyCells[idx];
-        board.setCellType(position.first, position.second, FOOD);
+        int index;
+        if constexpr (BoardT::IS_SPARSE) {
+            // No free list: draw cells until one is EMPTY (still uniform)
+            uint32_t cellCount = static_cast<uint32_t>(board.getCellCount());
+            do {
+                index = static_cast<int>(rng.below(cellCount));
+            } while (board.getCell(index) != EMPTY);
+        } else {
+            index = board.getFreeCell(static_cast<int>(rng.below(static_cast<uint32_t>(freeCount))));
+        }
+        position = {index / board.getStride(), index % board.getStride()};
+        board.setCell(index, FOOD);
+        exists = true;
+    }
+
+    /**
+     * @brief Puts the food on a known empty cell (restoring a saved game).
+     * @param index Row-major cell index
+     * @param board Reference to the game board
+     */
+    template<typename BoardT>
+    void placeAt(int index, BoardT& board) {
+        position = {index / board.getStride(), index % board.getStride()};
+        board.setCell(index, FOOD);
         exists = true;
     }
 
@@ -292,7 +794,8 @@ public:
      * @brief Removes the current food from the board.
      * @param board Reference to the game board
      */
-    void remove(Board& board) {
+    template<typename BoardT>
+    void remove(BoardT& board) {
         if (exists) {
             board.setCellType(position.first, position.second, EMPTY);
             exists = false;
@@ -321,7 +824,8 @@ public:
      * @param board Reference to the game board
      * @return True if out of bounds, false otherwise
      */
-    static bool isOutOfBounds(pair<int, int> pos, const Board& board) {
+    template<typename BoardT>
+    static bool isOutOfBounds(pair<int, int> pos, const BoardT& board) {
         return !board.isInBounds(pos.first, pos.second);
     }
 
@@ -331,10 +835,23 @@ public:
      * @param board Reference to the game board
      * @return True if wall detected, false otherwise
      */
-    static bool isWall(pair<int, int> pos, const Board& board) {
+    template<typename BoardT>
+    static bool isWall(pair<int, int> pos, const BoardT& board) {
         return board.getCellType(pos.first, pos.second) == WALL;
     }
 
+    /**
+     * @brief Checks if position runs the head into the snake's own body.
+     * @param pos Position to check
+     * @param board Reference to the game board
+     * @param snake Reference to the snake
+     * @return True if self-collision detected, false otherwise
+     */
+    template<typename BoardT>
+    static bool isSelfCollision(pair<int, int> pos, const BoardT& board, const Snake& snake) {
+        return snake.checkSelfCollision(pos, board);
+    }
+
     /**
      * @brief Checks if position matches food location.
      * @param pos Position to check
@@ -354,18 +871,34 @@ public:
  * @brief Manages direction changes with validation.
  * 
  * Ensures direction changes follow game rules (e.g., cannot reverse 180 degrees).
- * Provides thread-safe direction updates through atomic operations.
+ * Key presses travel from the input thread to the logic thread through a
+ * bounded wait-free single-producer/single-consumer ring, so quick
+ * successive turns within one tick are all kept. Each tick applies at most
+ * one valid turn; presses that would reverse or repeat the current
+ * direction are discarded, and the rest wait for later ticks.
  */
 class DirectionController {
+public:
+    /// Ring capacity; setMaxBufferedTurns() limits how much of it is used
+    static constexpr size_t INPUT_CAPACITY = 16;
+
 private:
+    struct TimedInput {
+        Direction direction;
+        int64_t timestamp;           ///< steady_clock nanoseconds, 0 if unstamped
+    };
+
     Direction current;
     Direction next;
-    atomic<int> atomicInput;
+    TimedInput inputs[INPUT_CAPACITY];
+    alignas(64) atomic<size_t> inputWrite;   ///< Written by the input thread only
+    alignas(64) atomic<size_t> inputRead;    ///< Written by the logic thread only
+    atomic<size_t> maxBuffered;
+    int64_t lastTurnLatency;
 
 public:
-    DirectionController() : current(NONE), next(NONE) {
-        atomicInput.store(static_cast<int>(NONE), memory_order_relaxed);
-    }
+    DirectionController() : current(NONE), next(NONE), inputs{}, inputWrite(0), inputRead(0),
+                            maxBuffered(3), lastTurnLatency(0) {}
 
     /**
      * @brief Validates if a direction change is allowed.
@@ -381,27 +914,75 @@ public:
     }
 
     /**
-     * @brief Sets the next direction (thread-safe).
-     * @param dir Direction to set
+     * @brief Limits how many presses may wait for upcoming ticks.
+     * @param turns Maximum queued presses, clamped to 1..INPUT_CAPACITY
+     */
+    void setMaxBufferedTurns(size_t turns) {
+        maxBuffered.store(min(max(turns, size_t(1)), INPUT_CAPACITY), memory_order_relaxed);
+    }
+
+    size_t getMaxBufferedTurns() const {
+        return maxBuffered.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Queues a direction press (thread-safe for one input thread).
+     * @param dir Direction pressed
+     * @param timestamp Press time in steady_clock nanoseconds, or 0
+     * @return False if the queue already holds the maximum buffered turns
      */
-    void setInput(Direction dir) {
-        atomicInput.store(static_cast<int>(dir), memory_order_release);
+    bool setInput(Direction dir, int64_t timestamp = 0) {
+        size_t write = inputWrite.load(memory_order_relaxed);
+        size_t read = inputRead.load(memory_order_acquire);
+        if (write - read >= maxBuffered.load(memory_order_relaxed)) {
+            return false;
+        }
+        inputs[write % INPUT_CAPACITY] = {dir, timestamp};
+        inputWrite.store(write + 1, memory_order_release);
+        return true;
     }
 
     /**
-     * @brief Processes input and updates current direction.
+     * @brief Applies the first queued press that is a valid turn.
+     * 
+     * Presses ahead of it that are invalid or repeat the current direction
+     * are dropped; presses behind it stay queued for the following ticks.
      */
     void processInput() {
-        int dirValue = atomicInput.exchange(static_cast<int>(NONE), memory_order_acquire);
-        Direction inputDir = static_cast<Direction>(dirValue);
+        size_t read = inputRead.load(memory_order_relaxed);
+        size_t write = inputWrite.load(memory_order_acquire);
         
-        if (inputDir != NONE && isValidChange(inputDir)) {
-            next = inputDir;
+        while (read != write) {
+            TimedInput input = inputs[read % INPUT_CAPACITY];
+            read++;
+            if (input.direction != NONE && input.direction != current && isValidChange(input.direction)) {
+                next = input.direction;
+                if (input.timestamp != 0) {
+                    lastTurnLatency = chrono::duration_cast<chrono::nanoseconds>(
+                        chrono::steady_clock::now().time_since_epoch()).count() - input.timestamp;
+                }
+                break;
+            }
         }
+        inputRead.store(read, memory_order_release);
         
         current = next;
     }
 
+    /**
+     * @brief Sets the direction of the next tick directly, dropping queued
+     * presses (logic thread).
+     *
+     * For a driver on the logic thread that decides every tick (the
+     * autopilot): it neither takes the input ring, which has one producer,
+     * nor waits behind presses already queued. A reversal or NONE keeps
+     * the current direction.
+     */
+    void steer(Direction dir) {
+        inputRead.store(inputWrite.load(memory_order_acquire), memory_order_release);
+        if (dir != NONE && isValidChange(dir)) next = dir;
+    }
+
     /**
      * @brief Calculates next position based on current direction.
      * @param currentPos Current position
@@ -421,12 +1002,41 @@ public:
         return {newRow, newCol};
     }
 
+    /**
+     * @brief Sets the starting direction and discards queued presses
+     * (call from the logic thread).
+     */
     void initialize(Direction initialDir) {
         current = initialDir;
         next = initialDir;
+        inputRead.store(inputWrite.load(memory_order_acquire), memory_order_release);
+        lastTurnLatency = 0;
     }
 
     Direction getCurrent() const { return current; }
+    size_t getPendingInputs() const {
+        return inputWrite.load(memory_order_acquire) - inputRead.load(memory_order_acquire);
+    }
+
+    /**
+     * @brief Copies the queued presses, oldest first (logic thread).
+     * @param out Room for INPUT_CAPACITY directions
+     * @return Number of presses copied
+     */
+    size_t copyPendingInputs(Direction* out) const {
+        size_t read = inputRead.load(memory_order_relaxed);
+        size_t write = inputWrite.load(memory_order_acquire);
+        size_t count = 0;
+        for (; read != write && count < INPUT_CAPACITY; read++) {
+            out[count++] = inputs[read % INPUT_CAPACITY].direction;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Nanoseconds from the last applied timestamped press to its tick.
+     */
+    int64_t getLastTurnLatency() const { return lastTurnLatency; }
 };
 
 // ============================================================================
@@ -434,22 +1044,208 @@ public:
 // ============================================================================
 
 /**
- * @brief Manages thread-safe publishing of game state snapshots.
+ * @brief Bounded single-producer/single-consumer queue of tick deltas.
  * 
- * Uses double buffering and atomic operations to provide lock-free
- * state updates between game logic and rendering threads.
+ * Wait-free on both ends. When the consumer falls behind, pushes fail; the
+ * publisher then snapshots and raises a drop flag so the consumer resyncs.
  */
-class StatePublisher {
+class DeltaQueue {
 private:
-    atomic<shared_ptr<const GameState>> currentState;
-    shared_ptr<GameState> writeBuffer;
-    shared_ptr<GameState> readBuffer;
+    vector<GameDelta> slots;
+    size_t mask;
+    alignas(64) atomic<size_t> readPos;
+    alignas(64) atomic<size_t> writePos;
 
 public:
-    StatePublisher() {
-        writeBuffer = make_shared<GameState>();
-        readBuffer = make_shared<GameState>();
-        currentState.store(writeBuffer, memory_order_relaxed);
+    DeltaQueue() : mask(0), readPos(0), writePos(0) {}
+
+    /**
+     * @brief Allocates the queue storage (not thread-safe; call before use).
+     * @param capacity Number of slots, rounded up to a power of two; 0 frees them
+     */
+    void reset(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size <<= 1;
+        if (capacity == 0) {
+            slots.clear();
+            slots.shrink_to_fit();
+            size = 1;
+        } else {
+            slots.assign(size, GameDelta{});
+        }
+        mask = size - 1;
+        readPos.store(0, memory_order_relaxed);
+        writePos.store(0, memory_order_relaxed);
+    }
+
+    bool isEnabled() const { return !slots.empty(); }
+
+    bool push(const GameDelta& delta) {
+        size_t write = writePos.load(memory_order_relaxed);
+        if (write - readPos.load(memory_order_acquire) > mask) return false;
+        slots[write & mask] = delta;
+        writePos.store(write + 1, memory_order_release);
+        return true;
+    }
+
+    bool pop(GameDelta& delta) {
+        size_t read = readPos.load(memory_order_relaxed);
+        if (read == writePos.load(memory_order_acquire)) return false;
+        delta = slots[read & mask];
+        readPos.store(read + 1, memory_order_release);
+        return true;
+    }
+};
+
+/**
+ * @brief Manages thread-safe publishing of game state snapshots.
+ * 
+ * A wait-free triple buffer: three preallocated GameState slots, one
+ * owned by the producer (back), one by the reader (front), and one in the
+ * middle holding the newest finished snapshot. publish() fills the back
+ * slot and swaps it into the middle with one atomic exchange; getState()
+ * swaps the middle out for its front slot, again one exchange, only when
+ * something new was published. The producer never writes to the front
+ * slot, so the frame a reader pinned stays whole until its next
+ * getState(), and reading it takes plain loads. Slots keep their buffers'
+ * capacity, so publishing stops allocating once each has been filled.
+ *
+ * There is one reader at a time: the render thread, or a StateMirror.
+ *
+ * Each tick can also be published as a GameDelta on an optional delta
+ * channel. Full snapshots are then only built every `keyframeInterval`
+ * ticks (0 = never on a schedule), when a consumer requests one, when a
+ * delta could not be queued, and when the game ends.
+ */
+class StatePublisher {
+private:
+    static constexpr uint8_t SLOT_MASK = 3;
+    static constexpr uint8_t FRESH = 4;  ///< Set in `middle` when the reader has not taken it yet
+
+    GameState slots[3];
+    uint8_t back;                        ///< Slot being written (producer only)
+    mutable uint8_t front;               ///< Slot pinned by the reader (reader only)
+    mutable atomic<uint8_t> middle;      ///< Newest finished slot, plus FRESH
+    DeltaQueue deltas;
+    int keyframeInterval;
+    int ticksSinceKeyframe;
+    atomic<bool> snapshotRequested;
+    atomic<bool> deltasDropped;
+    atomic<uint64_t> viewportOrigin;     ///< Requested window (row << 32 | col), sparse boards only
+    atomic<uint64_t> viewportSize;       ///< Requested window (rows << 32 | cols); 0 = around the head
+    atomic<uint64_t> publishedSize;      ///< Newest snapshot's buffer (rows << 32 | cols)
+    atomic<int> publishedScore;          ///< Newest snapshot's score
+    atomic<bool> publishedGameOver;      ///< Newest snapshot's game over flag
+
+    /// Window published on a sparse board before any viewport is requested
+    static constexpr int DEFAULT_VIEWPORT = 64;
+
+    /**
+     * @brief Copies the requested window of a sparse board into `target`.
+     */
+    template<typename BoardT>
+    void copyViewport(const BoardT& board, int32_t head, GameState& target) {
+        uint64_t size = viewportSize.load(memory_order_relaxed);
+        uint64_t origin = viewportOrigin.load(memory_order_relaxed);
+        int height = size ? static_cast<int>(size >> 32) : DEFAULT_VIEWPORT;
+        int width = size ? static_cast<int>(size & 0xFFFFFFFFu) : DEFAULT_VIEWPORT;
+        height = min(height, board.getRows());
+        width = min(width, board.getCols());
+        int row = static_cast<int>(origin >> 32);
+        int col = static_cast<int>(origin & 0xFFFFFFFFu);
+        if (!size && head >= 0) {
+            row = head / board.getStride() - height / 2;
+            col = head % board.getStride() - width / 2;
+        }
+        // A window moved by a late request is re-clamped rather than trusted
+        row = clamp(row, 0, board.getRows() - height);
+        col = clamp(col, 0, board.getCols() - width);
+
+        target.rows = height;
+        target.cols = width;
+        target.stride = width;
+        target.originRow = row;
+        target.originCol = col;
+        target.board.resize(static_cast<size_t>(height) * width);
+        board.copyWindow(row, col, height, width, target.board.data());
+    }
+
+public:
+    StatePublisher() : slots{}, back(2), front(0), middle(1), keyframeInterval(1), ticksSinceKeyframe(0),
+                       snapshotRequested(false), deltasDropped(false), viewportOrigin(0), viewportSize(0),
+                       publishedSize(0), publishedScore(0), publishedGameOver(false) {
+        for (GameState& slot : slots) slot.snakeHead = -1;
+    }
+
+    StatePublisher(const StatePublisher&) = delete;
+    StatePublisher& operator=(const StatePublisher&) = delete;
+
+    /**
+     * @brief Sets how often a full snapshot is built.
+     * @param ticks Snapshot every N ticks; 1 = every tick, 0 = only on demand
+     */
+    void setKeyframeInterval(int ticks) {
+        keyframeInterval = ticks;
+    }
+
+    /**
+     * @brief Enables or disables the delta channel.
+     * 
+     * Must be called while no consumer is reading deltas.
+     * @param capacity Queue capacity in ticks; 0 disables the channel
+     */
+    void setDeltaCapacity(size_t capacity) {
+        deltas.reset(capacity);
+    }
+
+    /**
+     * @brief Asks the producer to build a full snapshot on its next tick.
+     */
+    void requestSnapshot() {
+        snapshotRequested.store(true, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Chooses the window a sparse board publishes (thread-safe).
+     * 
+     * Dense boards always publish every cell and ignore this. The window is
+     * clamped to the board when the next snapshot is built.
+     */
+    void setViewport(int row, int col, int rows, int cols) {
+        viewportOrigin.store(static_cast<uint64_t>(max(row, 0)) << 32 | static_cast<uint32_t>(max(col, 0)),
+                             memory_order_relaxed);
+        viewportSize.store(static_cast<uint64_t>(max(rows, 1)) << 32 | static_cast<uint32_t>(max(cols, 1)),
+                           memory_order_relaxed);
+    }
+
+    /**
+     * @brief Publishes one tick: queues its delta and snapshots if due.
+     * @param delta Changes made by the tick
+     * @param board Game board
+     * @param snake Snake entity
+     * @param foodManager Food manager
+     * @param score Current score
+     * @param gameOver Game over flag
+     */
+    template<typename BoardT>
+    void publishTick(const GameDelta& delta, const BoardT& board, const Snake& snake,
+                     const FoodManager& foodManager, int score, bool gameOver) {
+        bool snapshotDue = gameOver || snapshotRequested.exchange(false, memory_order_relaxed);
+        bool dropped = deltas.isEnabled() && !deltas.push(delta);
+        
+        ticksSinceKeyframe++;
+        if (dropped || (keyframeInterval > 0 && ticksSinceKeyframe >= keyframeInterval)) {
+            snapshotDue = true;
+        }
+        
+        if (snapshotDue) {
+            publish(board, snake, foodManager, score, gameOver, delta.tick);
+        }
+        
+        // Raised after the snapshot so a consumer that sees it can resync
+        if (dropped) {
+            deltasDropped.store(true, memory_order_release);
+        }
     }
 
     /**
@@ -459,76 +1255,239 @@ public:
      * @param foodManager Food manager
      * @param score Current score
      * @param gameOver Game over flag
+     * @param tick Sequence number of this state
      */
-    void publish(const Board& board, const Snake& snake, const FoodManager& foodManager, 
-                 int score, bool gameOver) {
-        writeBuffer->rows = board.getRows();
-        writeBuffer->cols = board.getCols();
-        writeBuffer->score = score;
-        writeBuffer->gameOver = gameOver;
-        writeBuffer->food = foodManager.getPosition();
-        writeBuffer->foodExists = foodManager.isPresent();
-        writeBuffer->snake = snake.getBody();
-        writeBuffer->snakeLength = snake.getLength();
-        writeBuffer->board = board.getGrid();
+    template<typename BoardT>
+    void publish(const BoardT& board, const Snake& snake, const FoodManager& foodManager, 
+                 int score, bool gameOver, uint64_t tick) {
+        GameState& target = slots[back];
+        target.boardRows = board.getRows();
+        target.boardCols = board.getCols();
+        target.score = score;
+        target.gameOver = gameOver;
+        target.food = foodManager.getPosition();
+        target.foodExists = foodManager.isPresent();
+        SnakeBodyView body = snake.getBody();
+        target.snake.resize(body.size());
+        memcpy(target.snake.data(), body.first.data(), body.first.size_bytes());
+        memcpy(target.snake.data() + body.first.size(), body.second.data(), body.second.size_bytes());
+        target.snakeLength = snake.getLength();
+        target.snakeHead = body.size() > 0 ? static_cast<int32_t>(body[0]) : -1;
+        target.tick = tick;
+        if constexpr (BoardT::IS_SPARSE) {
+            copyViewport(board, target.snakeHead, target);
+        } else {
+            target.rows = board.getRows();
+            target.cols = board.getCols();
+            target.stride = board.getStride();
+            target.originRow = 0;
+            target.originCol = 0;
+            // Buffers keep their capacity across ticks, so this is a single memcpy
+            target.board.assign(board.data(), board.data() + board.getCellCount());
+        }
+        
+        publishedSize.store(static_cast<uint64_t>(target.rows) << 32 | static_cast<uint32_t>(target.cols),
+                            memory_order_relaxed);
+        publishedScore.store(score, memory_order_relaxed);
+        publishedGameOver.store(gameOver, memory_order_relaxed);
         
-        // Atomic swap with memory_order_release ensures visibility
-        currentState.store(writeBuffer, memory_order_release);
-        swap(writeBuffer, readBuffer);
+        // Release makes the slot's contents visible to the reader that takes it
+        back = middle.exchange(static_cast<uint8_t>(back | FRESH), memory_order_acq_rel) & SLOT_MASK;
+        ticksSinceKeyframe = 0;
+    }
+
+    /**
+     * @brief Pins the newest snapshot (reader thread).
+     * 
+     * The returned frame is not written to until the next getState() call;
+     * getPinnedState() gives it back without looking for a newer one.
+     * @return The newest published state
+     */
+    const GameState& getState() const {
+        if (middle.load(memory_order_relaxed) & FRESH) {
+            front = middle.exchange(front, memory_order_acq_rel) & SLOT_MASK;
+        }
+        return slots[front];
+    }
+
+    /**
+     * @brief The frame pinned by the last getState() (reader thread, plain loads).
+     */
+    const GameState& getPinnedState() const {
+        return slots[front];
     }
 
+    // Scalars of the newest snapshot, for any thread; reading them neither
+    // pins a frame nor releases the pinned one
+
+    int getPublishedRows() const { return static_cast<int>(publishedSize.load(memory_order_relaxed) >> 32); }
+    int getPublishedCols() const {
+        return static_cast<int>(publishedSize.load(memory_order_relaxed) & 0xFFFFFFFFu);
+    }
+    int getPublishedScore() const { return publishedScore.load(memory_order_relaxed); }
+    bool isPublishedGameOver() const { return publishedGameOver.load(memory_order_relaxed); }
+
+    /**
+     * @brief Takes the next queued delta (single consumer only).
+     * @param delta Receives the delta
+     * @return True if a delta was available
+     */
+    bool pollDelta(GameDelta& delta) {
+        return deltas.pop(delta);
+    }
+
+    /**
+     * @brief Reports and clears whether deltas were dropped (consumer side).
+     * @return True if the consumer must resync from a snapshot
+     */
+    bool takeDroppedFlag() {
+        return deltasDropped.exchange(false, memory_order_acquire);
+    }
+};
+
+/**
+ * @brief Consumer-side copy of the game state kept current from deltas.
+ * 
+ * Loads a full snapshot on first use and whenever deltas were lost, then
+ * applies deltas in order. This is the single delta consumer of
+ * its publisher.
+ */
+class StateMirror {
+private:
+    GameState state;
+    bool primed = false;
+
+    void resync(const StatePublisher& publisher) {
+        state = publisher.getState();
+        primed = true;
+    }
+
+public:
     /**
-     * @brief Gets the current game state (thread-safe).
-     * @return Shared pointer to immutable game state
+     * @brief Brings the mirror up to date with the publisher.
+     * @param publisher Publisher with the delta channel enabled
+     * @return The updated state
      */
-    shared_ptr<const GameState> getState() const {
-        return currentState.load(memory_order_acquire);
+    const GameState& sync(StatePublisher& publisher) {
+        if (!primed) resync(publisher);
+        
+        GameDelta delta;
+        while (true) {
+            while (publisher.pollDelta(delta)) {
+                if (delta.tick <= state.tick) continue;
+                if (delta.tick != state.tick + 1) {
+                    // A new game or lost deltas; the snapshot covers the gap
+                    resync(publisher);
+                    if (delta.tick <= state.tick) continue;
+                    if (delta.tick != state.tick + 1) {
+                        publisher.requestSnapshot();
+                        continue;
+                    }
+                }
+                state.applyDelta(delta);
+            }
+            
+            if (!publisher.takeDroppedFlag()) break;
+            resync(publisher);
+        }
+        return state;
     }
+
+    const GameState& get() const { return state; }
 };
 
 // ============================================================================
-// MAIN GAME LOGIC
+// SIMULATION CORE
 // ============================================================================
 
 /**
- * @brief Main game logic controller coordinating all game systems.
+ * @brief Everything besides the board and body that decides how a game goes on.
+ *
+ * Read with BasicSnakeSimulation::getResumeState() and passed back to
+ * restore(); checkpoint.h stores it on disk.
+ */
+struct ResumeState {
+    uint64_t tick;
+    int score;
+    int pointsPerFood;
+    bool gameOver;
+    GameOverCause gameOverCause;
+    uint32_t seed;                   ///< Food placement seed
+    uint64_t randomDraws;            ///< Numbers drawn from the seed so far
+    int growthPending;               ///< Segments the snake has yet to grow
+    int32_t food;                    ///< Packed cell index of the food, -1 if none
+    Direction direction;             ///< Current heading
+    size_t pendingInputCount;
+    Direction pendingInputs[DirectionController::INPUT_CAPACITY];   ///< Queued presses, oldest first
+};
+
+/**
+ * @brief Headless game core: the tick rules without any state publishing.
  * 
- * Orchestrates the interaction between Board, Snake, FoodManager, and other
- * components. Manages game loop updates, scoring, and state publishing.
- * Designed for thread-safe operation with separate game and render threads.
+ * Owns the board, snake, food and direction components and advances them
+ * one tick at a time, reporting each tick as a GameDelta. SnakeGameLogic
+ * wraps one of these with a StatePublisher; batch and headless drivers use
+ * it directly. Not copyable.
+ *
+ * BoardT selects runtime (`Board`) or compile-time (`FixedBoard<R, C>`)
+ * dimensions; `SnakeSimulation` is the runtime-sized version. RandomT is
+ * the food placement policy (see gameRandom.h); the mt19937 default
+ * replays games recorded by earlier versions.
  */
-class SnakeGameLogic {
+template<typename BoardT, typename RandomT = GameRandom>
+class BasicSnakeSimulation {
+public:
+    using BoardType = BoardT;
+    using RandomType = RandomT;
+
 private:
-    Board board;
+    RandomT rng;
+    BoardT board;
     Snake snake;
     FoodManager foodManager;
     DirectionController directionController;
-    StatePublisher statePublisher;
     
-    mt19937 rng;
     int score;
     int pointsPerFood;
     bool gameOver;
+    GameOverCause gameOverCause;
+    uint64_t tick;
+    uint32_t seed;
 
 public:
-    SnakeGameLogic() : foodManager(rng), score(0), pointsPerFood(10), gameOver(false) {
-        auto seed = chrono::high_resolution_clock::now().time_since_epoch().count();
-        rng.seed(static_cast<unsigned int>(seed));
+    BasicSnakeSimulation() : score(0), pointsPerFood(10), gameOver(false),
+                             gameOverCause(NOT_OVER), tick(0), seed(0) {}
+
+    BasicSnakeSimulation(const BasicSnakeSimulation&) = delete;
+    BasicSnakeSimulation& operator=(const BasicSnakeSimulation&) = delete;
+
+    /**
+     * @brief Derives a seed from the clock, for games that need not be reproducible.
+     */
+    static uint32_t makeSeed() {
+        auto now = chrono::high_resolution_clock::now().time_since_epoch().count();
+        return static_cast<uint32_t>(now ^ (now >> 32));
     }
 
     /**
-     * @brief Initializes the game with specified parameters.
+     * @brief Starts a new game with specified parameters.
+     * 
+     * The same seed and per-tick inputs always reproduce the same game.
      * @param rows Number of board rows
      * @param cols Number of board columns
      * @param startingLength Initial snake length
      * @param pointsPerFood Points awarded per food
      * @param initialDirection Starting movement direction
+     * @param seed Seed for food placement
      */
-    void initializeBoard(int rows, int cols, int startingLength, 
-                        int pointsPerFood, Direction initialDirection) {
+    void initialize(int rows, int cols, int startingLength, 
+                    int pointsPerFood, Direction initialDirection, uint32_t seed) {
+        this->seed = seed;
+        rng.seed(seed);
         this->pointsPerFood = pointsPerFood;
         score = 0;
         gameOver = false;
+        gameOverCause = NOT_OVER;
         
         board.initialize(rows, cols);
         directionController.initialize(initialDirection);
@@ -536,111 +1495,437 @@ public:
         pair<int, int> startPos = {rows / 2, cols / 2};
         snake.initialize(startPos, startingLength, initialDirection, board);
         
-        foodManager.placeRandom(board);
-        statePublisher.publish(board, snake, foodManager, score, gameOver);
+        foodManager.placeRandom(board, rng);
+        
+        // A new game is not reachable by deltas; consumers see the gap and resync
+        tick++;
+    }
+
+    /**
+     * @brief Starts a new game with the snake laid along explicit cells.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param body Packed cell indices of the snake, head first
+     * @param pointsPerFood Points awarded per food
+     * @param direction Current movement direction
+     * @param seed Seed for food placement
+     */
+    void initializeWithBody(int rows, int cols, span<const uint32_t> body,
+                            int pointsPerFood, Direction direction, uint32_t seed) {
+        this->seed = seed;
+        rng.seed(seed);
+        this->pointsPerFood = pointsPerFood;
+        score = 0;
+        gameOver = false;
+        gameOverCause = NOT_OVER;
+        
+        board.initialize(rows, cols);
+        directionController.initialize(direction);
+        snake.initializePath(body, board);
+        foodManager.placeRandom(board, rng);
+        tick++;
+    }
+
+    /**
+     * @brief Resumes a saved game.
+     * 
+     * Only the order of the board's free-cell set is not restored; it is
+     * rebuilt from the cells, so foods placed afterwards follow the same
+     * random stream but may land elsewhere than in the uninterrupted game.
+     * Restoring the same state always continues the same way.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param body Packed cell indices of the snake, head first (distinct,
+     *             in bounds and adjacent in order)
+     * @param state Scalars from getResumeState()
+     */
+    void restore(int rows, int cols, span<const uint32_t> body, const ResumeState& state) {
+        seed = state.seed;
+        rng.restore(state.seed, state.randomDraws);
+        pointsPerFood = state.pointsPerFood;
+        score = state.score;
+        gameOver = state.gameOver;
+        gameOverCause = state.gameOverCause;
+        
+        board.initialize(rows, cols);
+        directionController.initialize(state.direction);
+        for (size_t i = 0; i < min(state.pendingInputCount, DirectionController::INPUT_CAPACITY); i++) {
+            directionController.setInput(state.pendingInputs[i]);
+        }
+        snake.initializePath(body, board, state.growthPending);
+        if (state.food >= 0) {
+            foodManager.placeAt(state.food, board);
+        } else {
+            foodManager.remove(board);
+        }
+        tick = state.tick;
     }
 
     /**
-     * @brief Sets the snake direction (thread-safe input).
+     * @brief Captures the scalars restore() needs (logic thread).
+     */
+    ResumeState getResumeState() const {
+        ResumeState state = {};
+        state.tick = tick;
+        state.score = score;
+        state.pointsPerFood = pointsPerFood;
+        state.gameOver = gameOver;
+        state.gameOverCause = gameOverCause;
+        state.seed = seed;
+        state.randomDraws = rng.getDraws();
+        state.growthPending = snake.getPendingGrowth();
+        state.food = foodManager.isPresent()
+            ? board.toIndex(foodManager.getPosition().first, foodManager.getPosition().second) : -1;
+        state.direction = directionController.getCurrent();
+        state.pendingInputCount = directionController.copyPendingInputs(state.pendingInputs);
+        return state;
+    }
+
+    /**
+     * @brief Queues a direction press (thread-safe input).
      * @param newDir Direction to move
+     * @param timestamp Press time in steady_clock nanoseconds, or 0
      */
-    void setDirection(Direction newDir) {
-        directionController.setInput(newDir);
+    void setDirection(Direction newDir, int64_t timestamp = 0) {
+        directionController.setInput(newDir, timestamp);
     }
 
     /**
-     * @brief Updates the game state by one tick.
+     * @brief Sets the next tick's direction, bypassing the input queue (logic thread).
+     */
+    void steer(Direction newDir) {
+        directionController.steer(newDir);
+    }
+
+    /**
+     * @brief Limits how many presses may wait for upcoming ticks.
+     */
+    void setMaxBufferedTurns(size_t turns) {
+        directionController.setMaxBufferedTurns(turns);
+    }
+
+    /**
+     * @brief Advances the game by one tick.
+     * @param delta Receives the changes made by this tick
      * @return True if game continues, false if game over
      */
-    bool update() {
+    bool step(GameDelta& delta) {
+        delta = {tick, -1, -1, -1, -1, 0, gameOver};
         if (gameOver) {
             return false;
         }
         
+        delta.tick = ++tick;
+        
         // Process direction input
-        directionController.processInput();
+        {
+            SNAKE_PROFILE_SCOPE(PHASE_INPUT);
+            directionController.processInput();
+        }
         
         // Calculate next position
         pair<int, int> newHead = directionController.getNextPosition(snake.getHead());
         
         // Check collisions
-        if (CollisionDetector::isOutOfBounds(newHead, board)) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
+        {
+            SNAKE_PROFILE_SCOPE(PHASE_COLLISION);
+            if (CollisionDetector::isOutOfBounds(newHead, board) ||
+                CollisionDetector::isWall(newHead, board)) {
+                gameOverCause = HIT_WALL;
+            } else if (CollisionDetector::isSelfCollision(newHead, board, snake)) {
+                gameOverCause = HIT_SELF;
+            }
         }
-        
-        if (CollisionDetector::isWall(newHead, board)) {
+        if (gameOverCause != NOT_OVER) {
             gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+            delta.gameOver = true;
             return false;
         }
         
-        if (snake.checkSelfCollision(newHead)) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
-            return false;
-        }
+        int headIndex = board.toIndex(newHead.first, newHead.second);
         
         // Handle food collision
         if (CollisionDetector::isFood(newHead, foodManager)) {
             snake.grow();
             score += pointsPerFood;
+            delta.scoreDelta = pointsPerFood;
+            delta.foodRemoved = headIndex;
             foodManager.remove(board);
         }
         
         // Move snake
+        if (!snake.hasPendingGrowth()) {
+            delta.tailRemoved = static_cast<int32_t>(snake.getTailIndex());
+        }
         snake.move(newHead, board);
+        delta.headAdded = headIndex;
         
-        // Place new food if needed
+        // Place new food if needed; a full board with no growth left is a win
         if (!foodManager.isPresent()) {
-            foodManager.placeRandom(board);
+            if (board.getFreeCellCount() > 0) {
+                SNAKE_PROFILE_SCOPE(PHASE_FOOD);
+                foodManager.placeRandom(board, rng);
+                pair<int, int> food = foodManager.getPosition();
+                delta.foodAdded = board.toIndex(food.first, food.second);
+            } else if (!snake.hasPendingGrowth()) {
+                gameOver = true;
+                gameOverCause = BOARD_FILLED;
+                delta.gameOver = true;
+            }
         }
         
-        // Check win condition (board full)
-        if (!foodManager.isPresent() && !snake.hasPendingGrowth()) {
-            gameOver = true;
-            statePublisher.publish(board, snake, foodManager, score, gameOver);
+        return !gameOver;
+    }
+
+    const BoardT& getBoard() const { return board; }
+    const Snake& getSnake() const { return snake; }
+    const FoodManager& getFoodManager() const { return foodManager; }
+    Direction getDirection() const { return directionController.getCurrent(); }
+    int64_t getLastTurnLatency() const { return directionController.getLastTurnLatency(); }
+    int getScore() const { return score; }
+    bool isGameOver() const { return gameOver; }
+    GameOverCause getGameOverCause() const { return gameOverCause; }
+    uint64_t getTick() const { return tick; }
+    uint32_t getSeed() const { return seed; }
+};
+
+/// Simulation with runtime board dimensions
+using SnakeSimulation = BasicSnakeSimulation<Board>;
+
+// ============================================================================
+// MAIN GAME LOGIC
+// ============================================================================
+
+/**
+ * @brief Main game logic controller coordinating all game systems.
+ * 
+ * Orchestrates the interaction between Board, Snake, FoodManager, and other
+ * components. Manages game loop updates, scoring, and state publishing.
+ * Designed for thread-safe operation with separate game and render threads.
+ *
+ * `SnakeGameLogic` sizes its board at runtime; `FixedSnakeGameLogic<R, C>`
+ * fixes it at compile time (see visitBoardType()). RandomT picks the food
+ * RNG (e.g. `Pcg32Random`), as for BasicSnakeSimulation.
+ */
+template<typename BoardT, typename RandomT = GameRandom>
+class BasicSnakeGameLogic {
+public:
+    using BoardType = BoardT;
+    using RandomType = RandomT;
+    using Simulation = BasicSnakeSimulation<BoardT, RandomT>;
+
+private:
+    Simulation simulation;
+    StatePublisher statePublisher;
+    GameDelta lastDelta;
+
+    void publishSnapshot() {
+        statePublisher.publish(simulation.getBoard(), simulation.getSnake(),
+                               simulation.getFoodManager(), simulation.getScore(),
+                               simulation.isGameOver(), simulation.getTick());
+    }
+
+public:
+    BasicSnakeGameLogic() : lastDelta{} {}
+
+    /**
+     * @brief Initializes the game with specified parameters.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param startingLength Initial snake length
+     * @param pointsPerFood Points awarded per food
+     * @param initialDirection Starting movement direction
+     * @param seed Seed for food placement (clock-derived if omitted)
+     */
+    void initializeBoard(int rows, int cols, int startingLength, 
+                        int pointsPerFood, Direction initialDirection,
+                        uint32_t seed = SnakeSimulation::makeSeed()) {
+        simulation.initialize(rows, cols, startingLength, pointsPerFood, initialDirection, seed);
+        lastDelta = {simulation.getTick(), -1, -1, -1, -1, 0, false};
+        publishSnapshot();
+    }
+
+    /**
+     * @brief Initializes the game with the snake laid along explicit cells.
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param body Packed cell indices of the snake, head first
+     * @param pointsPerFood Points awarded per food
+     * @param direction Current movement direction
+     * @param seed Seed for food placement
+     */
+    void initializeWithBody(int rows, int cols, span<const uint32_t> body,
+                            int pointsPerFood, Direction direction, uint32_t seed) {
+        simulation.initializeWithBody(rows, cols, body, pointsPerFood, direction, seed);
+        lastDelta = {simulation.getTick(), -1, -1, -1, -1, 0, false};
+        publishSnapshot();
+    }
+
+    /**
+     * @brief Resumes a saved game (see BasicSnakeSimulation::restore()).
+     * @param rows Number of board rows
+     * @param cols Number of board columns
+     * @param body Packed cell indices of the snake, head first
+     * @param state Scalars from getSimulation().getResumeState()
+     */
+    void restore(int rows, int cols, span<const uint32_t> body, const ResumeState& state) {
+        simulation.restore(rows, cols, body, state);
+        lastDelta = {simulation.getTick(), -1, -1, -1, -1, 0, simulation.isGameOver()};
+        publishSnapshot();
+    }
+
+    /**
+     * @brief Queues a direction press, stamped with the current time
+     * (thread-safe input).
+     * @param newDir Direction to move
+     */
+    void setDirection(Direction newDir) {
+        int64_t now = chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count();
+        simulation.setDirection(newDir, now);
+    }
+
+    /**
+     * @brief Sets the next tick's direction, bypassing the input queue (logic thread).
+     */
+    void steer(Direction newDir) {
+        simulation.steer(newDir);
+    }
+
+    /**
+     * @brief Limits how many presses may wait for upcoming ticks.
+     */
+    void setMaxBufferedTurns(size_t turns) {
+        simulation.setMaxBufferedTurns(turns);
+    }
+
+    /**
+     * @brief Updates the game state by one tick.
+     * @return True if game continues, false if game over
+     */
+    bool update() {
+        if (simulation.isGameOver()) {
             return false;
         }
         
+        SNAKE_PROFILE_SCOPE(PHASE_TICK);
+        bool alive = simulation.step(lastDelta);
+        
         // Publish updated state
-        statePublisher.publish(board, snake, foodManager, score, gameOver);
-        return true;
+        SNAKE_PROFILE_SCOPE(PHASE_PUBLISH);
+        statePublisher.publishTick(lastDelta, simulation.getBoard(), simulation.getSnake(),
+                                   simulation.getFoodManager(), simulation.getScore(),
+                                   simulation.isGameOver());
+        return alive;
+    }
+
+    /**
+     * @brief Gets the simulation core (game thread only).
+     */
+    const Simulation& getSimulation() const {
+        return simulation;
+    }
+
+    // ========================================================================
+    // STATE PUBLISHING CONTROL
+    // ========================================================================
+
+    /**
+     * @brief Sets how often full snapshots are published (see StatePublisher).
+     * @param ticks Snapshot every N ticks; 1 = every tick, 0 = only on demand
+     */
+    void setKeyframeInterval(int ticks) {
+        statePublisher.setKeyframeInterval(ticks);
+    }
+
+    /**
+     * @brief Enables the delta channel; call before the consumer starts.
+     * @param capacity Queue capacity in ticks; 0 disables deltas
+     */
+    void setDeltaCapacity(size_t capacity) {
+        static_assert(!BoardT::IS_SPARSE,
+                      "Sparse boards publish a moving viewport, which deltas cannot keep current");
+        statePublisher.setDeltaCapacity(capacity);
+    }
+
+    /**
+     * @brief Asks for a full snapshot on the next tick (thread-safe).
+     */
+    void requestSnapshot() {
+        statePublisher.requestSnapshot();
+    }
+
+    /**
+     * @brief Chooses the window snapshots of a sparse board hold (thread-safe).
+     */
+    void setViewport(int row, int col, int rows, int cols) {
+        statePublisher.setViewport(row, col, rows, cols);
+    }
+
+    /**
+     * @brief Takes the next queued delta (single consumer thread only).
+     */
+    bool pollDelta(GameDelta& delta) {
+        return statePublisher.pollDelta(delta);
+    }
+
+    /**
+     * @brief Brings a consumer-side mirror up to date (single consumer only).
+     */
+    const GameState& syncMirror(StateMirror& mirror) {
+        return mirror.sync(statePublisher);
+    }
+
+    /**
+     * @brief Gets the delta of the most recent tick (game thread only).
+     */
+    const GameDelta& getLastDelta() const {
+        return lastDelta;
     }
 
     // ========================================================================
     // THREAD-SAFE ACCESSORS (for render thread)
     // ========================================================================
 
-    shared_ptr<const GameState> getGameState() const {
+    /**
+     * @brief Pins the newest published state (one reader thread at a time).
+     * @return Frame that stays unchanged until the next getGameState()
+     */
+    const GameState& getGameState() const {
         return statePublisher.getState();
     }
 
+    // The scalar accessors read the newest published state (any thread)
+    // without moving the pinned frame
+
     int getRows() const {
-        auto state = statePublisher.getState();
-        return state->rows;
+        return statePublisher.getPublishedRows();
     }
 
     int getCols() const {
-        auto state = statePublisher.getState();
-        return state->cols;
+        return statePublisher.getPublishedCols();
     }
 
     int getScore() const {
-        auto state = statePublisher.getState();
-        return state->score;
+        return statePublisher.getPublishedScore();
     }
 
     bool isGameOver() const {
-        auto state = statePublisher.getState();
-        return state->gameOver;
+        return statePublisher.isPublishedGameOver();
     }
 
+    /**
+     * @brief Reads a cell of the frame pinned by the last getGameState()
+     * (reader thread).
+     *
+     * Does not pin a newer frame, so a loop over cells sees one consistent
+     * state and takes no atomic per call; call getGameState() before the
+     * loop, or this reads an older frame (all WALL before the first pin).
+     */
     int getCellType(int r, int c) const {
-        auto state = statePublisher.getState();
-        if (r >= 0 && r < state->rows && c >= 0 && c < state->cols) {
-            return state->board[r][c];
+        const GameState& state = statePublisher.getPinnedState();
+        if (r >= 0 && r < state.rows && c >= 0 && c < state.cols) {
+            return state.cellAt(r, c);
         }
         return WALL;
     }
@@ -667,4 +1952,28 @@ public:
     static Direction getDirectionRight() { return RIGHT; }
 };
 
+/// Game with runtime board dimensions
+using SnakeGameLogic = BasicSnakeGameLogic<Board>;
+
+/// Game with compile-time board dimensions
+template<int Rows, int Cols>
+using FixedSnakeGameLogic = BasicSnakeGameLogic<FixedBoard<Rows, Cols>>;
+
+/**
+ * @brief Calls `visit` with the board type to use for a given size.
+ * 
+ * The common sizes (20x40, 32x32, 64x64) map to their FixedBoard
+ * instantiations, compiled into every caller; any other size gets the
+ * runtime-sized Board.
+ * @param visit Callable taking `type_identity<BoardT>`
+ * @return Whatever `visit` returns
+ */
+template<typename Visitor>
+decltype(auto) visitBoardType(int rows, int cols, Visitor&& visit) {
+    if (rows == 20 && cols == 40) return visit(type_identity<FixedBoard<20, 40>>{});
+    if (rows == 32 && cols == 32) return visit(type_identity<FixedBoard<32, 32>>{});
+    if (rows == 64 && cols == 64) return visit(type_identity<FixedBoard<64, 64>>{});
+    return visit(type_identity<Board>{});
+}
+
 #endif // GAMELOGIC_H
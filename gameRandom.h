@@ -0,0 +1,345 @@
+// gameRandom.h
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <cstdint>
+#include <random>
+
+using namespace std;
+
+// ============================================================================
+// RANDOM ENGINES
+// ============================================================================
+//
+// Food placement takes its numbers from a policy type (BasicGameRandom<Engine>)
+// chosen as a template parameter of BasicSnakeSimulation / BasicSnakeGameLogic.
+// Every engine yields 32-bit numbers, is seeded from a 64-bit key and can
+// skip ahead, which is how a game's random state is rebuilt from (seed,
+// draws). They differ in size and in how fast they skip:
+//
+//   Mt19937Engine     2.5 KB, skip O(n)       the default; reproduces older games
+//   Pcg32Engine       16 B,   skip O(log n)   PCG XSH-RR 64/32
+//   Xoshiro256Engine  32 B,   skip O(n)       xoshiro256**, high 32 bits of each output
+//   PhiloxEngine      32 B,   skip O(1)       Philox4x32-10, counter-based
+//
+// Bounded draws use Lemire's nearly-divisionless method, which is also what
+// libstdc++'s uniform_int_distribution does with a 32-bit engine, so the
+// mt19937 default places food exactly where it did before.
+
+/**
+ * @brief splitmix64: a tiny, fast random stream, also used to expand keys.
+ */
+class SplitMix64 {
+private:
+    uint64_t state;
+
+public:
+    explicit SplitMix64(uint64_t seed = 0) : state(seed) {}
+
+    void seed(uint64_t value) { state = value; }
+
+    /// The splitmix64 finalizer: a bijective 64-bit mix
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t next() {
+        return mix(state += 0x9E3779B97F4A7C15ull);
+    }
+
+    /// Uniform in [0, bound), bound > 0
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+};
+
+/**
+ * @brief Key of stream `streamId` under `masterSeed` (a game, session,
+ * episode or worker).
+ *
+ * For one master seed distinct ids always give distinct keys, and
+ * neighbouring ids give unrelated ones, so engines seeded from them run
+ * independent streams wherever the games are played.
+ */
+inline uint64_t deriveStreamKey(uint64_t masterSeed, uint64_t streamId) {
+    return SplitMix64::mix(masterSeed ^ SplitMix64::mix(streamId + 0x9E3779B97F4A7C15ull));
+}
+
+/**
+ * @brief A 32-bit game seed for stream `streamId` (game seeds are 32-bit,
+ * as replays and checkpoints store them).
+ */
+inline uint32_t deriveStreamSeed(uint64_t masterSeed, uint64_t streamId) {
+    return static_cast<uint32_t>(deriveStreamKey(masterSeed, streamId) >> 32);
+}
+
+/**
+ * @brief std::mt19937 in the engine interface; the key's low 32 bits are the seed.
+ */
+class Mt19937Engine {
+private:
+    mt19937 engine;
+
+public:
+    using result_type = uint32_t;
+
+    explicit Mt19937Engine(uint64_t key = mt19937::default_seed) : engine(static_cast<uint32_t>(key)) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    void seed(uint64_t key) { engine.seed(static_cast<uint32_t>(key)); }
+    result_type operator()() { return static_cast<result_type>(engine()); }
+    void discard(uint64_t count) { engine.discard(count); }
+};
+
+/**
+ * @brief PCG32 (XSH-RR output over a 64-bit LCG); the key picks both the
+ * start and one of 2^63 increments.
+ */
+class Pcg32Engine {
+private:
+    static constexpr uint64_t MULTIPLIER = 6364136223846793005ull;
+
+    uint64_t state;
+    uint64_t increment;
+
+public:
+    using result_type = uint32_t;
+
+    explicit Pcg32Engine(uint64_t key = 0) { seed(key); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    void seed(uint64_t key) {
+        SplitMix64 expand(key);
+        uint64_t start = expand.next();
+        increment = (expand.next() << 1) | 1;
+        state = 0;
+        (*this)();
+        state += start;
+        (*this)();
+    }
+
+    result_type operator()() {
+        uint64_t old = state;
+        state = old * MULTIPLIER + increment;
+        uint32_t shifted = static_cast<uint32_t>(((old >> 18) ^ old) >> 27);
+        uint32_t rotation = static_cast<uint32_t>(old >> 59);
+        return (shifted >> rotation) | (shifted << ((32 - rotation) & 31));
+    }
+
+    /**
+     * @brief Skips `count` outputs in O(log count) (Brown's LCG jump).
+     */
+    void discard(uint64_t count) {
+        uint64_t multiplier = MULTIPLIER;
+        uint64_t plus = increment;
+        uint64_t totalMultiplier = 1;
+        uint64_t totalPlus = 0;
+        for (; count > 0; count >>= 1) {
+            if (count & 1) {
+                totalMultiplier *= multiplier;
+                totalPlus = totalPlus * multiplier + plus;
+            }
+            plus = (multiplier + 1) * plus;
+            multiplier *= multiplier;
+        }
+        state = totalMultiplier * state + totalPlus;
+    }
+};
+
+/**
+ * @brief xoshiro256**, giving the upper 32 bits of each 64-bit output.
+ */
+class Xoshiro256Engine {
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    using result_type = uint32_t;
+
+    explicit Xoshiro256Engine(uint64_t key = 0) { seed(key); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    // splitmix64 never yields four zero words, the one state xoshiro must avoid
+    void seed(uint64_t key) {
+        SplitMix64 expand(key);
+        for (uint64_t& word : s) word = expand.next();
+    }
+
+    result_type operator()() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return static_cast<result_type>(result >> 32);
+    }
+
+    void discard(uint64_t count) {
+        for (; count > 0; count--) (*this)();
+    }
+};
+
+/**
+ * @brief Philox4x32-10: output block n is a keyed bijection of n.
+ *
+ * Nothing carries over from one block to the next, so any position in
+ * the stream is reached in O(1), and the key alone separates streams.
+ */
+class PhiloxEngine {
+private:
+    uint32_t key[2];
+    uint64_t block;                  ///< Counter of the next block to generate
+    uint32_t output[4];
+    unsigned used;                   ///< Words of `output` already returned
+
+    void generate() {
+        uint32_t c[4] = {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), 0, 0};
+        uint32_t k0 = key[0];
+        uint32_t k1 = key[1];
+        for (int round = 0; round < 10; round++) {
+            uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c[0];
+            uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c[2];
+            uint32_t next[4] = {static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<uint32_t>(p1),
+                                static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<uint32_t>(p0)};
+            c[0] = next[0];
+            c[1] = next[1];
+            c[2] = next[2];
+            c[3] = next[3];
+            k0 += 0x9E3779B9u;
+            k1 += 0xBB67AE85u;
+        }
+        output[0] = c[0];
+        output[1] = c[1];
+        output[2] = c[2];
+        output[3] = c[3];
+        block++;
+        used = 0;
+    }
+
+public:
+    using result_type = uint32_t;
+
+    explicit PhiloxEngine(uint64_t seedKey = 0) { seed(seedKey); }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    void seed(uint64_t seedKey) {
+        key[0] = static_cast<uint32_t>(seedKey);
+        key[1] = static_cast<uint32_t>(seedKey >> 32);
+        block = 0;
+        used = 4;
+    }
+
+    result_type operator()() {
+        if (used == 4) generate();
+        return output[used++];
+    }
+
+    /**
+     * @brief Skips `count` outputs in O(1).
+     */
+    void discard(uint64_t count) {
+        uint64_t buffered = 4 - used;
+        if (count < buffered) {
+            used += static_cast<unsigned>(count);
+            return;
+        }
+        count -= buffered;
+        block += count / 4;
+        used = 4;
+        if (count % 4 != 0) {
+            generate();
+            used = static_cast<unsigned>(count % 4);
+        }
+    }
+};
+
+// ============================================================================
+// GAME RANDOM POLICY
+// ============================================================================
+
+/**
+ * @brief A random engine that counts its draws.
+ *
+ * The random state of a game is then (seed, draws), a few portable bytes
+ * whatever the engine, and restore() rebuilds it by skipping ahead.
+ * below() draws bounded numbers for food placement without a
+ * distribution object.
+ */
+template<typename Engine>
+class BasicGameRandom {
+private:
+    Engine engine;
+    uint64_t draws;
+
+public:
+    using EngineType = Engine;
+    using result_type = uint32_t;
+
+    explicit BasicGameRandom(uint32_t seed = mt19937::default_seed) : engine(seed), draws(0) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+
+    result_type operator()() {
+        draws++;
+        return engine();
+    }
+
+    /**
+     * @brief Uniform in [0, bound), bound > 0 (Lemire's nearly-divisionless method).
+     *
+     * One multiply per draw; the division for the rejection threshold only
+     * happens in the rare case the low half lands below `bound`.
+     */
+    uint32_t below(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>((*this)()) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>((*this)()) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    void seed(uint32_t value) {
+        engine.seed(value);
+        draws = 0;
+    }
+
+    /**
+     * @brief Puts the engine where it was after `drawCount` draws from `value`.
+     */
+    void restore(uint32_t value, uint64_t drawCount) {
+        engine.seed(value);
+        engine.discard(drawCount);
+        draws = drawCount;
+    }
+
+    uint64_t getDraws() const { return draws; }
+};
+
+/// mt19937: the default, placing food exactly as earlier versions did
+using GameRandom = BasicGameRandom<Mt19937Engine>;
+using Pcg32Random = BasicGameRandom<Pcg32Engine>;
+using Xoshiro256Random = BasicGameRandom<Xoshiro256Engine>;
+using PhiloxRandom = BasicGameRandom<PhiloxEngine>;
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,1395 @@
+// gameServer.h
+#ifndef GAMESERVER_H
+#define GAMESERVER_H
+
+#include "gameApp.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #pragma comment(lib, "ws2_32.lib")
+#else
+    #include <arpa/inet.h>
+    #include <fcntl.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+#endif
+
+// Readiness backend: epoll on Linux, kqueue on the BSDs and macOS, and
+// poll() / WSAPoll() everywhere else. Define SNAKE_SERVER_USE_POLL to force
+// the portable one.
+#if defined(SNAKE_SERVER_USE_POLL) || defined(_WIN32)
+    #define SNAKE_POLLER_POLL
+    #ifndef _WIN32
+        #include <poll.h>
+    #endif
+#elif defined(__linux__)
+    #define SNAKE_POLLER_EPOLL
+    #include <sys/epoll.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+    #define SNAKE_POLLER_KQUEUE
+    #include <sys/event.h>
+    #include <sys/time.h>
+#else
+    #define SNAKE_POLLER_POLL
+    #include <poll.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// SOCKETS
+// ============================================================================
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = INVALID_SOCKET;
+#else
+using SocketHandle = int;
+constexpr SocketHandle INVALID_SOCKET_HANDLE = -1;
+#endif
+
+/**
+ * @brief Thin portable wrappers over the BSD socket calls the server uses.
+ */
+class SocketApi {
+public:
+    /// Result of socketSend/socketRecv when the call would block
+    static constexpr long WOULD_BLOCK = -1;
+    /// Result of socketSend/socketRecv on a connection error
+    static constexpr long FAILED = -2;
+
+    /**
+     * @brief Starts the socket library (WSAStartup on Windows, no-op elsewhere).
+     */
+    static bool startup() {
+#ifdef _WIN32
+        WSADATA data;
+        return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+#else
+        return true;
+#endif
+    }
+
+    static void cleanup() {
+#ifdef _WIN32
+        WSACleanup();
+#endif
+    }
+
+    static void closeSocket(SocketHandle socket) {
+#ifdef _WIN32
+        closesocket(socket);
+#else
+        close(socket);
+#endif
+    }
+
+    static bool setNonBlocking(SocketHandle socket) {
+#ifdef _WIN32
+        u_long enabled = 1;
+        return ioctlsocket(socket, FIONBIO, &enabled) == 0;
+#else
+        int flags = fcntl(socket, F_GETFL, 0);
+        return flags >= 0 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+    }
+
+    static void setNoDelay(SocketHandle socket) {
+        int enabled = 1;
+        setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&enabled), sizeof(enabled));
+#ifdef SO_NOSIGPIPE
+        setsockopt(socket, SOL_SOCKET, SO_NOSIGPIPE, &enabled, sizeof(enabled));
+#endif
+    }
+
+    /**
+     * @brief Opens a non-blocking listening socket.
+     * @param address IPv4 address to bind, e.g. "0.0.0.0"
+     * @param port TCP port
+     * @return The socket, or INVALID_SOCKET_HANDLE on failure
+     */
+    static SocketHandle listenOn(const string& address, uint16_t port) {
+        SocketHandle socket = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (socket == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+
+        int reuse = 1;
+        setsockopt(socket, SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+
+        sockaddr_in bindAddress{};
+        bindAddress.sin_family = AF_INET;
+        bindAddress.sin_port = htons(port);
+        if (inet_pton(AF_INET, address.c_str(), &bindAddress.sin_addr) != 1 ||
+            ::bind(socket, reinterpret_cast<sockaddr*>(&bindAddress), sizeof(bindAddress)) != 0 ||
+            ::listen(socket, SOMAXCONN) != 0 ||
+            !setNonBlocking(socket)) {
+            closeSocket(socket);
+            return INVALID_SOCKET_HANDLE;
+        }
+        return socket;
+    }
+
+    /**
+     * @brief Accepts one pending connection as a non-blocking socket.
+     * @return The socket, or INVALID_SOCKET_HANDLE if none is pending
+     */
+    static SocketHandle acceptFrom(SocketHandle listener) {
+#if defined(__linux__)
+        SocketHandle socket = accept4(listener, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (socket == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+#else
+        SocketHandle socket = accept(listener, nullptr, nullptr);
+        if (socket == INVALID_SOCKET_HANDLE) return INVALID_SOCKET_HANDLE;
+        if (!setNonBlocking(socket)) {
+            closeSocket(socket);
+            return INVALID_SOCKET_HANDLE;
+        }
+#endif
+        setNoDelay(socket);
+        return socket;
+    }
+
+    /**
+     * @return Bytes sent, WOULD_BLOCK, or FAILED
+     */
+    static long socketSend(SocketHandle socket, const char* data, size_t size) {
+#ifdef _WIN32
+        int sent = send(socket, data, static_cast<int>(size), 0);
+        if (sent >= 0) return sent;
+        return WSAGetLastError() == WSAEWOULDBLOCK ? WOULD_BLOCK : FAILED;
+#else
+    #ifdef MSG_NOSIGNAL
+        ssize_t sent = send(socket, data, size, MSG_NOSIGNAL);
+    #else
+        ssize_t sent = send(socket, data, size, 0);
+    #endif
+        if (sent >= 0) return static_cast<long>(sent);
+        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) return WOULD_BLOCK;
+        return FAILED;
+#endif
+    }
+
+    /**
+     * @return Bytes received (0 = peer closed), WOULD_BLOCK, or FAILED
+     */
+    static long socketRecv(SocketHandle socket, char* data, size_t size) {
+#ifdef _WIN32
+        int received = recv(socket, data, static_cast<int>(size), 0);
+        if (received >= 0) return received;
+        return WSAGetLastError() == WSAEWOULDBLOCK ? WOULD_BLOCK : FAILED;
+#else
+        ssize_t received = recv(socket, data, size, 0);
+        if (received >= 0) return static_cast<long>(received);
+        if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) return WOULD_BLOCK;
+        return FAILED;
+#endif
+    }
+};
+
+// ============================================================================
+// READINESS POLLER
+// ============================================================================
+
+/**
+ * @brief One readiness notification from Poller::wait().
+ */
+struct PollEvent {
+    uint32_t token;      ///< Token the socket was registered with
+    bool readable;       ///< Data, EOF or an error is waiting to be read
+    bool writable;       ///< Send buffer has room (only when write interest is on)
+};
+
+/**
+ * @brief Level-triggered socket readiness over epoll, kqueue or poll.
+ *
+ * Every socket is watched for reads; write interest is switched on only
+ * while a connection has output the kernel would not take.
+ */
+class Poller {
+private:
+#if defined(SNAKE_POLLER_EPOLL)
+    int epollFd;
+    vector<epoll_event> ready;
+#elif defined(SNAKE_POLLER_KQUEUE)
+    int queueFd;
+    vector<struct kevent> ready;
+#else
+    #ifdef _WIN32
+    using PollDescriptor = WSAPOLLFD;
+    #else
+    using PollDescriptor = pollfd;
+    #endif
+    vector<PollDescriptor> descriptors;
+    vector<uint32_t> tokens;
+    unordered_map<SocketHandle, size_t> slots;
+#endif
+
+public:
+    Poller() {
+#if defined(SNAKE_POLLER_EPOLL)
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        ready.resize(1024);
+#elif defined(SNAKE_POLLER_KQUEUE)
+        queueFd = kqueue();
+        ready.resize(1024);
+#endif
+    }
+
+    ~Poller() {
+#if defined(SNAKE_POLLER_EPOLL)
+        if (epollFd >= 0) close(epollFd);
+#elif defined(SNAKE_POLLER_KQUEUE)
+        if (queueFd >= 0) close(queueFd);
+#endif
+    }
+
+    Poller(const Poller&) = delete;
+    Poller& operator=(const Poller&) = delete;
+
+    static const char* backendName() {
+#if defined(SNAKE_POLLER_EPOLL)
+        return "epoll";
+#elif defined(SNAKE_POLLER_KQUEUE)
+        return "kqueue";
+#elif defined(_WIN32)
+        return "WSAPoll";
+#else
+        return "poll";
+#endif
+    }
+
+    bool isValid() const {
+#if defined(SNAKE_POLLER_EPOLL)
+        return epollFd >= 0;
+#elif defined(SNAKE_POLLER_KQUEUE)
+        return queueFd >= 0;
+#else
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Starts watching a socket for reads.
+     */
+    bool add(SocketHandle socket, uint32_t token) {
+#if defined(SNAKE_POLLER_EPOLL)
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = token;
+        return epoll_ctl(epollFd, EPOLL_CTL_ADD, socket, &event) == 0;
+#elif defined(SNAKE_POLLER_KQUEUE)
+        struct kevent changes[2];
+        void* data = reinterpret_cast<void*>(static_cast<uintptr_t>(token));
+        EV_SET(&changes[0], socket, EVFILT_READ, EV_ADD, 0, 0, data);
+        EV_SET(&changes[1], socket, EVFILT_WRITE, EV_ADD | EV_DISABLE, 0, 0, data);
+        return kevent(queueFd, changes, 2, nullptr, 0, nullptr) == 0;
+#else
+        slots[socket] = descriptors.size();
+        PollDescriptor descriptor{};
+        descriptor.fd = socket;
+        descriptor.events = POLLIN;
+        descriptors.push_back(descriptor);
+        tokens.push_back(token);
+        return true;
+#endif
+    }
+
+    /**
+     * @brief Switches write readiness notifications on or off.
+     */
+    void setWriteInterest(SocketHandle socket, uint32_t token, bool enabled) {
+#if defined(SNAKE_POLLER_EPOLL)
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | (enabled ? uint32_t(EPOLLOUT) : 0u);
+        event.data.u64 = token;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, socket, &event);
+#elif defined(SNAKE_POLLER_KQUEUE)
+        struct kevent change;
+        EV_SET(&change, socket, EVFILT_WRITE, enabled ? EV_ENABLE : EV_DISABLE, 0, 0,
+               reinterpret_cast<void*>(static_cast<uintptr_t>(token)));
+        kevent(queueFd, &change, 1, nullptr, 0, nullptr);
+#else
+        (void)token;
+        auto slot = slots.find(socket);
+        if (slot != slots.end()) {
+            descriptors[slot->second].events = POLLIN | (enabled ? POLLOUT : 0);
+        }
+#endif
+    }
+
+    /**
+     * @brief Stops watching a socket; call before closing it.
+     */
+    void remove(SocketHandle socket) {
+#if defined(SNAKE_POLLER_EPOLL)
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, socket, nullptr);
+#elif defined(SNAKE_POLLER_KQUEUE)
+        struct kevent changes[2];
+        EV_SET(&changes[0], socket, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+        EV_SET(&changes[1], socket, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+        kevent(queueFd, changes, 2, nullptr, 0, nullptr);
+#else
+        auto slot = slots.find(socket);
+        if (slot == slots.end()) return;
+        size_t index = slot->second;
+        slots.erase(slot);
+        if (index + 1 != descriptors.size()) {
+            descriptors[index] = descriptors.back();
+            tokens[index] = tokens.back();
+            slots[descriptors[index].fd] = index;
+        }
+        descriptors.pop_back();
+        tokens.pop_back();
+#endif
+    }
+
+    /**
+     * @brief Waits for readiness.
+     * @param events Cleared, then filled with what is ready
+     * @param timeoutMs Longest wait in milliseconds, -1 for no limit
+     * @return False on a poller error (an interrupted wait is not one)
+     */
+    bool wait(vector<PollEvent>& events, int timeoutMs) {
+        events.clear();
+#if defined(SNAKE_POLLER_EPOLL)
+        int count = epoll_wait(epollFd, ready.data(), static_cast<int>(ready.size()), timeoutMs);
+        if (count < 0) return errno == EINTR;
+        for (int i = 0; i < count; i++) {
+            uint32_t flags = ready[i].events;
+            events.push_back({static_cast<uint32_t>(ready[i].data.u64),
+                              (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) != 0,
+                              (flags & EPOLLOUT) != 0});
+        }
+#elif defined(SNAKE_POLLER_KQUEUE)
+        timespec timeout = {timeoutMs / 1000, (timeoutMs % 1000) * 1000000L};
+        int count = kevent(queueFd, nullptr, 0, ready.data(), static_cast<int>(ready.size()),
+                           timeoutMs < 0 ? nullptr : &timeout);
+        if (count < 0) return errno == EINTR;
+        for (int i = 0; i < count; i++) {
+            uint32_t token = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(ready[i].udata));
+            bool readable = ready[i].filter == EVFILT_READ || (ready[i].flags & (EV_EOF | EV_ERROR));
+            events.push_back({token, readable, ready[i].filter == EVFILT_WRITE});
+        }
+#else
+    #ifdef _WIN32
+        int count = WSAPoll(descriptors.data(), static_cast<ULONG>(descriptors.size()), timeoutMs);
+        if (count < 0) return false;
+    #else
+        int count = poll(descriptors.data(), descriptors.size(), timeoutMs);
+        if (count < 0) return errno == EINTR;
+    #endif
+        for (size_t i = 0; i < descriptors.size() && count > 0; i++) {
+            short flags = descriptors[i].revents;
+            if (!flags) continue;
+            count--;
+            events.push_back({tokens[i], (flags & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) != 0,
+                              (flags & POLLOUT) != 0});
+        }
+#endif
+        return true;
+    }
+};
+
+// ============================================================================
+// TIMER WHEEL
+// ============================================================================
+
+/**
+ * @brief Hashed timing wheel for many periodic timers.
+ *
+ * Timers are identified by small integers (session ids) and stored in
+ * intrusive lists, one per slot, so scheduling and cancelling are O(1) and
+ * never allocate once the node table has grown to the largest id. A slot
+ * holds every timer whose deadline falls in that resolution step modulo
+ * the wheel size; timers further out than one turn simply wait for a later
+ * pass over their slot.
+ */
+class TimerWheel {
+private:
+    static constexpr uint32_t NIL = UINT32_MAX;
+
+    struct Node {
+        uint32_t next;
+        uint32_t prev;
+        uint64_t deadlineTick;
+        bool armed;
+    };
+
+    vector<uint32_t> heads;
+    vector<Node> nodes;
+    uint64_t resolutionMs;
+    uint64_t nextTick;           ///< First resolution step not yet expired
+    size_t armedCount;
+
+    void unlink(uint32_t id) {
+        Node& node = nodes[id];
+        if (node.prev != NIL) nodes[node.prev].next = node.next;
+        else heads[node.deadlineTick % heads.size()] = node.next;
+        if (node.next != NIL) nodes[node.next].prev = node.prev;
+        node.armed = false;
+        armedCount--;
+    }
+
+    template<typename Expire>
+    void expireSlot(size_t slot, uint64_t limit, Expire& expire) {
+        uint32_t id = heads[slot];
+        while (id != NIL) {
+            uint32_t next = nodes[id].next;
+            if (nodes[id].deadlineTick <= limit) {
+                unlink(id);
+                expire(id);
+            }
+            id = next;
+        }
+    }
+
+public:
+    /**
+     * @param slotCount Slots per turn
+     * @param resolution Length of one slot in milliseconds
+     */
+    explicit TimerWheel(size_t slotCount = 512, uint64_t resolution = 5)
+        : heads(slotCount, NIL), resolutionMs(resolution), nextTick(0), armedCount(0) {}
+
+    void start(uint64_t nowMs) {
+        nextTick = nowMs / resolutionMs;
+    }
+
+    /**
+     * @brief Arms (or re-arms) a timer. Deadlines already due fire on the next advance().
+     */
+    void schedule(uint32_t id, uint64_t deadlineMs) {
+        if (id >= nodes.size()) {
+            nodes.resize(id + 1, Node{NIL, NIL, 0, false});
+        }
+        if (nodes[id].armed) unlink(id);
+
+        uint64_t tick = max(deadlineMs / resolutionMs, nextTick);
+        size_t slot = tick % heads.size();
+        Node& node = nodes[id];
+        node.deadlineTick = tick;
+        node.prev = NIL;
+        node.next = heads[slot];
+        node.armed = true;
+        if (node.next != NIL) nodes[node.next].prev = id;
+        heads[slot] = id;
+        armedCount++;
+    }
+
+    void cancel(uint32_t id) {
+        if (id < nodes.size() && nodes[id].armed) unlink(id);
+    }
+
+    size_t getArmedCount() const { return armedCount; }
+
+    /**
+     * @brief Milliseconds until the next slot is due, -1 if nothing is armed.
+     */
+    int getTimeoutMs(uint64_t nowMs) const {
+        if (armedCount == 0) return -1;
+        uint64_t due = nextTick * resolutionMs;
+        return due > nowMs ? static_cast<int>(due - nowMs) : 0;
+    }
+
+    /**
+     * @brief Fires every timer due by `nowMs`, calling `expire(id)` for each.
+     *
+     * A timer re-armed from inside `expire` for a deadline that has already
+     * passed fires again within the same call, so lagging timers catch up.
+     */
+    template<typename Expire>
+    void advance(uint64_t nowMs, Expire&& expire) {
+        uint64_t target = nowMs / resolutionMs;
+        if (armedCount == 0 || target < nextTick) {
+            nextTick = max(nextTick, target + 1);
+            return;
+        }
+
+        if (target - nextTick >= heads.size()) {
+            // Stalled for more than a turn: one pass over every slot covers all due timers
+            nextTick = target + 1;
+            for (size_t slot = 0; slot < heads.size(); slot++) {
+                expireSlot(slot, target, expire);
+            }
+            return;
+        }
+
+        while (nextTick <= target) {
+            uint64_t tick = nextTick++;
+            expireSlot(tick % heads.size(), target, expire);
+        }
+    }
+};
+
+// ============================================================================
+// WEBSOCKET HANDSHAKE HELPERS
+// ============================================================================
+
+/**
+ * @brief SHA-1 digest, needed only for the WebSocket accept key (RFC 6455).
+ */
+inline array<uint8_t, 20> sha1Digest(string_view message) {
+    uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+    string padded(message);
+    uint64_t bitLength = static_cast<uint64_t>(message.size()) * 8;
+    padded += static_cast<char>(0x80);
+    while (padded.size() % 64 != 56) padded += '\0';
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        padded += static_cast<char>((bitLength >> shift) & 0xFF);
+    }
+
+    auto rotl = [](uint32_t x, int n) { return (x << n) | (x >> (32 - n)); };
+    for (size_t block = 0; block < padded.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; i++) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(padded.data() + block + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+        }
+        for (int i = 16; i < 80; i++) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; i++) {
+            uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d;
+            d = c;
+            c = rotl(b, 30);
+            b = a;
+            a = temp;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    array<uint8_t, 20> digest;
+    for (int i = 0; i < 20; i++) {
+        digest[i] = static_cast<uint8_t>(h[i / 4] >> (24 - 8 * (i % 4)));
+    }
+    return digest;
+}
+
+inline string base64Encode(const uint8_t* data, size_t size) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string encoded;
+    encoded.reserve((size + 2) / 3 * 4);
+    for (size_t i = 0; i < size; i += 3) {
+        uint32_t group = uint32_t(data[i]) << 16;
+        if (i + 1 < size) group |= uint32_t(data[i + 1]) << 8;
+        if (i + 2 < size) group |= data[i + 2];
+        encoded += alphabet[(group >> 18) & 63];
+        encoded += alphabet[(group >> 12) & 63];
+        encoded += i + 1 < size ? alphabet[(group >> 6) & 63] : '=';
+        encoded += i + 2 < size ? alphabet[group & 63] : '=';
+    }
+    return encoded;
+}
+
+/**
+ * @brief Sec-WebSocket-Accept value for a client's Sec-WebSocket-Key.
+ */
+inline string webSocketAcceptKey(string_view clientKey) {
+    string input(clientKey);
+    input += "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    array<uint8_t, 20> digest = sha1Digest(input);
+    return base64Encode(digest.data(), digest.size());
+}
+
+// ============================================================================
+// CONNECTION OUTPUT
+// ============================================================================
+
+/**
+ * @brief Per-connection output the kernel has not accepted yet.
+ *
+ * Frames are appended whole and pushed with non-blocking sends; whatever
+ * does not fit stays here until the socket turns writable. Large buffers
+ * are released once drained, so idle connections cost next to nothing.
+ */
+class OutputBuffer {
+private:
+    static constexpr size_t RETAINED_CAPACITY = 4096;
+
+    string data;
+    size_t sent = 0;
+
+public:
+    size_t pending() const { return data.size() - sent; }
+
+    void append(string_view bytes) {
+        data.append(bytes.data(), bytes.size());
+    }
+
+    /**
+     * @brief Sends as much as the socket takes.
+     * @return False if the connection failed
+     */
+    bool flush(SocketHandle socket) {
+        while (pending() > 0) {
+            long written = SocketApi::socketSend(socket, data.data() + sent, pending());
+            if (written == SocketApi::WOULD_BLOCK) break;
+            if (written < 0) return false;
+            sent += static_cast<size_t>(written);
+        }
+
+        if (pending() == 0) {
+            if (data.capacity() > RETAINED_CAPACITY) string().swap(data);
+            else data.clear();
+            sent = 0;
+        } else if (sent > data.size() / 2) {
+            data.erase(0, sent);
+            sent = 0;
+        }
+        return true;
+    }
+};
+
+// ============================================================================
+// NETWORK SESSIONS
+// ============================================================================
+
+enum class NetProtocol : uint8_t {
+    TELNET,
+    WEBSOCKET
+};
+
+enum class SessionPhase : uint8_t {
+    HANDSHAKE,      ///< WebSocket upgrade request not complete yet
+    WAITING,        ///< Instructions shown, waiting for a key to start
+    PLAYING,        ///< Ticking on the timer wheel
+    GAME_OVER,      ///< Waiting for R (replay) or Q (quit)
+    CLOSING         ///< Closed once the remaining output is flushed
+};
+
+/**
+ * @brief Server-side settings on top of the game's GameConfig.
+ */
+struct ServerConfig {
+    string bindAddress = "0.0.0.0";
+    uint16_t telnetPort = 2323;          ///< 0 disables the telnet listener
+    uint16_t webSocketPort = 8080;       ///< 0 disables the WebSocket listener
+    size_t maxSessions = 16384;
+    size_t maxPendingOutput = 64 * 1024; ///< Frames are skipped while more than this is unsent
+};
+
+/**
+ * @brief One connected player: a headless simulation plus its screen and socket.
+ *
+ * The game runs on the same BasicSnakeSimulation that SnakeGameLogic wraps;
+ * the server is single-threaded, so no state publishing is needed and the
+ * screen is updated straight from each tick's GameDelta.
+ */
+template<typename BoardT>
+struct NetSession {
+    SocketHandle socket = INVALID_SOCKET_HANDLE;
+    NetProtocol protocol = NetProtocol::TELNET;
+    SessionPhase phase = SessionPhase::WAITING;
+    bool writeInterest = false;
+    bool stale = false;              ///< Frames were skipped; next frame diffs every cell
+    uint8_t escapeState = 0;         ///< Progress through an ESC [ X arrow sequence
+    uint8_t telnetState = 0;         ///< Progress through an IAC command
+    int32_t shownHead = -1;          ///< Cell drawn with the head glyph
+    int shownScore = -1;
+    int shownLength = -1;
+    int bestScore = 0;
+    uint64_t nextTickMs = 0;
+
+    BasicSnakeSimulation<BoardT> simulation;
+    vector<char> shownCells;         ///< What the client's screen shows, per cell
+    string inbound;                  ///< Unparsed bytes (WebSocket only)
+    OutputBuffer output;
+};
+
+// ============================================================================
+// GAME SERVER
+// ============================================================================
+
+/**
+ * @brief Hosts many snake games in one process on a single event loop.
+ *
+ * Players connect over telnet (ANSI output, character mode negotiated) or
+ * WebSocket (ANSI text frames, e.g. for xterm.js). One thread does
+ * everything: the Poller reports socket readiness, one TimerWheel drives
+ * every session's ticks, and each connection has its own non-blocking
+ * OutputBuffer. A client that stops reading only loses frames; its screen
+ * is resynchronized by a full diff once its backlog drains.
+ */
+template<typename BoardT>
+class GameServer {
+private:
+    using Session = NetSession<BoardT>;
+
+    static constexpr uint32_t TELNET_LISTENER = 0;
+    static constexpr uint32_t WEBSOCKET_LISTENER = 1;
+    static constexpr uint32_t FIRST_SESSION_TOKEN = 2;
+    static constexpr int HEADER_ROWS = 6;
+    static constexpr size_t MAX_HANDSHAKE_BYTES = 8192;
+    static constexpr size_t MAX_FRAME_PAYLOAD = 4096;
+
+    GameConfig config;
+    ServerConfig serverConfig;
+    Poller poller;
+    TimerWheel timers;
+    SocketHandle telnetListener;
+    SocketHandle webSocketListener;
+
+    vector<unique_ptr<Session>> sessions;
+    vector<uint32_t> freeIds;
+    vector<uint32_t> retiredIds;     ///< Closed this batch; reused only after it
+    size_t sessionCount;
+    uint64_t gamesStarted;
+    uint32_t masterSeed;             ///< Game g is seeded from stream g of this
+
+    // Per-frame scratch, reused across sessions
+    string frame;
+    int cursorRow;
+    int cursorCol;
+
+    static uint64_t nowMs() {
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    // ------------------------------------------------------------------
+    // Screen composition (into `frame`)
+    // ------------------------------------------------------------------
+
+    void moveCursor(int row, int col) {
+        if (row == cursorRow && col == cursorCol) return;
+        TerminalController::appendCursorMove(frame, row, col);
+        cursorRow = row;
+        cursorCol = col;
+    }
+
+    void emit(char glyph) {
+        frame += glyph;
+        cursorCol++;
+    }
+
+    char glyphFor(const Session& session, int index, int headIndex) const {
+        switch (session.simulation.getBoard().getCell(index)) {
+            case EMPTY: return config.emptyChar;
+            case SNAKE: return index == headIndex ? config.snakeHeadChar : config.snakeBodyChar;
+            case FOOD:  return config.foodChar;
+            case WALL:  return config.wallChar;
+            default:    return config.emptyChar;
+        }
+    }
+
+    int headIndexOf(const Session& session) const {
+        const auto& simulation = session.simulation;
+        if (simulation.getSnake().getLength() == 0) return -1;
+        pair<int, int> head = simulation.getSnake().getHead();
+        return simulation.getBoard().toIndex(head.first, head.second);
+    }
+
+    void drawCell(Session& session, int index, int headIndex) {
+        if (index < 0) return;
+        char glyph = glyphFor(session, index, headIndex);
+        if (session.shownCells[index] == glyph) return;
+        int stride = session.simulation.getBoard().getStride();
+        moveCursor(HEADER_ROWS + index / stride, 1 + index % stride);
+        emit(glyph);
+        session.shownCells[index] = glyph;
+    }
+
+    void drawScore(Session& session) {
+        int score = session.simulation.getScore();
+        int length = static_cast<int>(session.simulation.getSnake().getLength());
+        if (score == session.shownScore && length == session.shownLength) return;
+
+        char line[96];
+        int size = snprintf(line, sizeof(line), "  Score: %4d  |  Length: %3d  |  Best: %4d  ",
+                            score, length, max(session.bestScore, score));
+        moveCursor(4, 0);
+        frame.append(line, size);
+        cursorCol += size;
+        session.shownScore = score;
+        session.shownLength = length;
+    }
+
+    /**
+     * @brief Redrawn cells: all of them when stale, else only those the delta touched.
+     */
+    void composeTick(Session& session, const GameDelta* delta) {
+        int headIndex = headIndexOf(session);
+        if (delta && !session.stale) {
+            drawCell(session, session.shownHead, headIndex);
+            drawCell(session, delta->tailRemoved, headIndex);
+            drawCell(session, delta->foodRemoved, headIndex);
+            drawCell(session, delta->headAdded, headIndex);
+            drawCell(session, delta->foodAdded, headIndex);
+        } else {
+            for (int i = 0; i < session.simulation.getBoard().getCellCount(); i++) {
+                drawCell(session, i, headIndex);
+            }
+            session.stale = false;
+        }
+        session.shownHead = headIndex;
+        drawScore(session);
+    }
+
+    void composeFullScreen(Session& session, bool showInstructions) {
+        const auto& board = session.simulation.getBoard();
+        string border = "+" + string(board.getCols(), '-') + "+\r\n";
+        string blankRow = "|" + string(board.getCols(), ' ') + "|\r\n";
+
+        frame += "\033[H\033[J\033[?25l\r\n";
+        frame += "  +===============================+\r\n";
+        frame += "  |       SNAKE GAME              |\r\n";
+        frame += "  +===============================+\r\n\r\n";
+        frame += border;
+        for (int r = 0; r < board.getRows(); r++) frame += blankRow;
+        frame += border;
+        frame += "\r\n";
+        if (showInstructions) {
+            frame += "  +===================================+\r\n";
+            frame += "  |  CONTROLS:                        |\r\n";
+            frame += "  |                                   |\r\n";
+            frame += "  |  W or UP Arrow    - Move UP       |\r\n";
+            frame += "  |  S or DOWN Arrow  - Move DOWN     |\r\n";
+            frame += "  |  A or LEFT Arrow  - Move LEFT     |\r\n";
+            frame += "  |  D or RIGHT Arrow - Move RIGHT    |\r\n";
+            frame += "  |  Q                - Quit Game     |\r\n";
+            frame += "  |                                   |\r\n";
+            frame += "  |  Press ENTER to start...          |\r\n";
+            frame += "  +===================================+\r\n";
+        } else {
+            frame += "  Controls: Arrow Keys or WASD  |  Q: Quit\r\n";
+        }
+        cursorRow = -1;
+        cursorCol = -1;
+
+        session.shownCells.assign(static_cast<size_t>(board.getCellCount()), ' ');
+        session.shownScore = -1;
+        session.shownLength = -1;
+        session.stale = true;
+        composeTick(session, nullptr);
+    }
+
+    void composeGameOver(Session& session) {
+        int messageRow = HEADER_ROWS + session.simulation.getBoard().getRows() + 3;
+        char score[64];
+        moveCursor(messageRow, 0);
+        frame += "\r\n";
+        frame += "  +===============================+\r\n";
+        frame += "  |         GAME OVER!            |\r\n";
+        snprintf(score, sizeof(score), "  |   Final Score: %4d          |\r\n", session.simulation.getScore());
+        frame += score;
+        snprintf(score, sizeof(score), "  |   Best Score:  %4d          |\r\n", session.bestScore);
+        frame += score;
+        frame += "  |                               |\r\n";
+        frame += "  |   Press R to Replay           |\r\n";
+        frame += "  |   Press Q to Quit             |\r\n";
+        frame += "  +===============================+\r\n";
+        cursorRow = -1;
+        cursorCol = -1;
+    }
+
+    // ------------------------------------------------------------------
+    // Output
+    // ------------------------------------------------------------------
+
+    static void appendWebSocketHeader(string& out, uint8_t opcode, size_t size) {
+        out += static_cast<char>(0x80 | opcode);
+        if (size < 126) {
+            out += static_cast<char>(size);
+        } else if (size <= 0xFFFF) {
+            out += static_cast<char>(126);
+            out += static_cast<char>(size >> 8);
+            out += static_cast<char>(size & 0xFF);
+        } else {
+            out += static_cast<char>(127);
+            for (int shift = 56; shift >= 0; shift -= 8) {
+                out += static_cast<char>((size >> shift) & 0xFF);
+            }
+        }
+    }
+
+    /**
+     * @brief Queues `frame` (wrapped for the session's protocol) and clears it.
+     */
+    void queueFrame(Session& session, uint8_t opcode = 0x1) {
+        if (frame.empty() && opcode == 0x1) return;
+        SNAKE_PROFILE_COUNT(COUNTER_FRAMES, 1);
+        SNAKE_PROFILE_COUNT(COUNTER_FRAME_BYTES, frame.size());
+        if (session.protocol == NetProtocol::WEBSOCKET && session.phase != SessionPhase::HANDSHAKE) {
+            string header;
+            appendWebSocketHeader(header, opcode, frame.size());
+            session.output.append(header);
+        }
+        session.output.append(frame);
+        frame.clear();
+    }
+
+    /**
+     * @brief Pushes queued output and keeps write interest in step with it.
+     * @return False if the session was closed
+     */
+    bool flushSession(uint32_t id) {
+        Session& session = *sessions[id];
+        if (!session.output.flush(session.socket)) {
+            closeSession(id);
+            return false;
+        }
+        bool backlog = session.output.pending() > 0;
+        if (!backlog && session.phase == SessionPhase::CLOSING) {
+            closeSession(id);
+            return false;
+        }
+        if (backlog != session.writeInterest) {
+            poller.setWriteInterest(session.socket, id + FIRST_SESSION_TOKEN, backlog);
+            session.writeInterest = backlog;
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------
+    // Session lifecycle
+    // ------------------------------------------------------------------
+
+    void openSession(SocketHandle socket, NetProtocol protocol) {
+        uint32_t id;
+        if (!freeIds.empty()) {
+            id = freeIds.back();
+            freeIds.pop_back();
+        } else {
+            id = static_cast<uint32_t>(sessions.size());
+            sessions.emplace_back();
+        }
+        if (!poller.add(socket, id + FIRST_SESSION_TOKEN)) {
+            SocketApi::closeSocket(socket);
+            freeIds.push_back(id);
+            return;
+        }
+
+        sessions[id] = make_unique<Session>();
+        Session& session = *sessions[id];
+        session.socket = socket;
+        session.protocol = protocol;
+        sessionCount++;
+        resetGame(session);
+
+        if (protocol == NetProtocol::WEBSOCKET) {
+            session.phase = SessionPhase::HANDSHAKE;
+            return;
+        }
+
+        // IAC WILL ECHO, IAC WILL SUPPRESS-GO-AHEAD, IAC DONT LINEMODE: character mode, no local echo
+        frame.assign("\xFF\xFB\x01\xFF\xFB\x03\xFF\xFE\x22");
+        composeFullScreen(session, true);
+        queueFrame(session);
+        flushSession(id);
+    }
+
+    void closeSession(uint32_t id) {
+        Session& session = *sessions[id];
+        timers.cancel(id);
+        poller.remove(session.socket);
+        SocketApi::closeSocket(session.socket);
+        sessions[id].reset();
+        retiredIds.push_back(id);
+        sessionCount--;
+    }
+
+    void resetGame(Session& session) {
+        uint32_t seed = deriveStreamSeed(masterSeed, gamesStarted);
+        gamesStarted++;
+        session.simulation.initialize(config.rows, config.cols, config.startingLength,
+                                      config.pointsPerFood, RIGHT, seed);
+        session.simulation.setMaxBufferedTurns(static_cast<size_t>(config.maxBufferedTurns));
+        session.shownHead = -1;
+        session.phase = SessionPhase::WAITING;
+    }
+
+    void startGame(uint32_t id) {
+        Session& session = *sessions[id];
+        session.phase = SessionPhase::PLAYING;
+        session.nextTickMs = nowMs() + config.updateDelay;
+        timers.schedule(id, session.nextTickMs);
+    }
+
+    void quit(uint32_t id) {
+        Session& session = *sessions[id];
+        timers.cancel(id);
+        if (session.phase == SessionPhase::HANDSHAKE) {
+            // Not a WebSocket yet: nothing to say, just hang up
+        } else if (session.protocol == NetProtocol::WEBSOCKET) {
+            frame = "\033[?25h\r\n  Thanks for playing!\r\n";
+            queueFrame(session);
+            queueFrame(session, 0x8);
+        } else {
+            frame = "\033[H\033[J\033[?25h\r\n  Thanks for playing!\r\n\r\n";
+            queueFrame(session);
+        }
+        session.phase = SessionPhase::CLOSING;
+    }
+
+    /**
+     * @brief Runs one tick of a session from the timer wheel.
+     */
+    void tickSession(uint32_t id, uint64_t now) {
+        Session& session = *sessions[id];
+        GameDelta delta;
+        bool running;
+        {
+            SNAKE_PROFILE_SCOPE(PHASE_TICK);
+            running = session.simulation.step(delta);
+        }
+
+        if (session.output.pending() > serverConfig.maxPendingOutput) {
+            session.stale = true;
+        } else {
+            SNAKE_PROFILE_SCOPE(PHASE_RENDER);
+            composeTick(session, &delta);
+        }
+
+        if (!running) {
+            // Always shown, even to a client that is behind
+            session.phase = SessionPhase::GAME_OVER;
+            session.bestScore = max(session.bestScore, session.simulation.getScore());
+            if (session.stale) composeTick(session, nullptr);
+            composeGameOver(session);
+        } else {
+            // Absolute deadlines; a session that fell far behind drops the missed ticks
+            session.nextTickMs += config.updateDelay;
+            uint64_t lag = static_cast<uint64_t>(config.updateDelay) * max(config.maxCatchUpTicks, 1);
+            if (session.nextTickMs + lag < now) session.nextTickMs = now + config.updateDelay;
+            timers.schedule(id, session.nextTickMs);
+        }
+        queueFrame(session);
+        flushSession(id);
+    }
+
+    // ------------------------------------------------------------------
+    // Input
+    // ------------------------------------------------------------------
+
+    void pressDirection(uint32_t id, Direction direction) {
+        Session& session = *sessions[id];
+        if (session.phase == SessionPhase::WAITING) {
+            composeFullScreen(session, false);
+            startGame(id);
+        }
+        if (session.phase == SessionPhase::PLAYING) {
+            session.simulation.setDirection(direction);
+        }
+    }
+
+    /**
+     * @brief Handles one decoded key. @return False once the session is quitting.
+     */
+    bool handleKey(uint32_t id, unsigned char key) {
+        Session& session = *sessions[id];
+
+        if (session.escapeState == 1) {
+            session.escapeState = (key == '[' || key == 'O') ? 2 : 0;
+            return true;
+        }
+        if (session.escapeState == 2) {
+            session.escapeState = 0;
+            switch (key) {
+                case 'A': pressDirection(id, UP); break;
+                case 'B': pressDirection(id, DOWN); break;
+                case 'C': pressDirection(id, RIGHT); break;
+                case 'D': pressDirection(id, LEFT); break;
+            }
+            return true;
+        }
+
+        switch (key) {
+            case 0x1B: session.escapeState = 1; break;
+            case 'w': case 'W': pressDirection(id, UP); break;
+            case 's': case 'S': pressDirection(id, DOWN); break;
+            case 'a': case 'A': pressDirection(id, LEFT); break;
+            case 'd': case 'D': pressDirection(id, RIGHT); break;
+            case 'q': case 'Q': case 0x03: case 0x04:
+                quit(id);
+                return false;
+            case 'r': case 'R': case '\r': case '\n': case ' ':
+                if (session.phase == SessionPhase::GAME_OVER) {
+                    resetGame(session);
+                    composeFullScreen(session, false);
+                    startGame(id);
+                } else if (session.phase == SessionPhase::WAITING) {
+                    composeFullScreen(session, false);
+                    startGame(id);
+                }
+                break;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Strips telnet commands (IAC ...) and feeds the rest as keys.
+     */
+    void receiveTelnet(uint32_t id, const char* data, size_t size) {
+        enum : uint8_t { DATA, COMMAND, OPTION, SUBNEGOTIATION, SUBNEGOTIATION_IAC };
+        for (size_t i = 0; i < size; i++) {
+            Session& session = *sessions[id];
+            unsigned char byte = static_cast<unsigned char>(data[i]);
+            switch (session.telnetState) {
+                case DATA:
+                    if (byte == 0xFF) session.telnetState = COMMAND;
+                    else if (byte != 0 && !handleKey(id, byte)) return;
+                    break;
+                case COMMAND:
+                    if (byte >= 0xFB && byte <= 0xFE) session.telnetState = OPTION;    // WILL/WONT/DO/DONT
+                    else if (byte == 0xFA) session.telnetState = SUBNEGOTIATION;
+                    else session.telnetState = DATA;
+                    break;
+                case OPTION:
+                    session.telnetState = DATA;
+                    break;
+                case SUBNEGOTIATION:
+                    if (byte == 0xFF) session.telnetState = SUBNEGOTIATION_IAC;
+                    break;
+                case SUBNEGOTIATION_IAC:
+                    session.telnetState = byte == 0xF0 ? DATA : SUBNEGOTIATION;
+                    break;
+            }
+        }
+    }
+
+    /**
+     * @brief Completes the HTTP upgrade once the request headers are in.
+     */
+    void receiveHandshake(uint32_t id) {
+        Session& session = *sessions[id];
+        size_t end = session.inbound.find("\r\n\r\n");
+        if (end == string::npos) {
+            if (session.inbound.size() > MAX_HANDSHAKE_BYTES) quit(id);
+            return;
+        }
+
+        string headers = session.inbound.substr(0, end + 2);
+        session.inbound.erase(0, end + 4);
+        string lower = headers;
+        for (char& ch : lower) ch = static_cast<char>(tolower(static_cast<unsigned char>(ch)));
+
+        // Plain HTTP on the WebSocket port: the profiler report as JSON
+        if (lower.compare(0, 11, "get /stats ") == 0) {
+            frame = Profiler::instance().report().toJson();
+            frame = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+                    to_string(frame.size()) + "\r\nConnection: close\r\n\r\n" + frame;
+            queueFrame(session);
+            session.phase = SessionPhase::CLOSING;
+            return;
+        }
+
+        size_t keyStart = lower.find("\r\nsec-websocket-key:");
+        if (keyStart == string::npos) {
+            frame = "HTTP/1.1 400 Bad Request\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+            queueFrame(session);
+            session.phase = SessionPhase::CLOSING;
+            return;
+        }
+        keyStart += strlen("\r\nsec-websocket-key:");
+        size_t keyEnd = headers.find("\r\n", keyStart);
+        string key = headers.substr(keyStart, keyEnd - keyStart);
+        key.erase(0, key.find_first_not_of(" \t"));
+        key.erase(key.find_last_not_of(" \t") + 1);
+
+        frame = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+                "Sec-WebSocket-Accept: " + webSocketAcceptKey(key) + "\r\n\r\n";
+        queueFrame(session);
+        session.phase = SessionPhase::WAITING;
+        string().swap(headers);
+
+        composeFullScreen(session, true);
+        queueFrame(session);
+    }
+
+    /**
+     * @brief Decodes complete client frames (always masked) from `inbound`.
+     */
+    void receiveWebSocket(uint32_t id) {
+        Session& session = *sessions[id];
+        string& in = session.inbound;
+        size_t offset = 0;
+
+        while (session.phase != SessionPhase::CLOSING && in.size() - offset >= 2) {
+            const unsigned char* p = reinterpret_cast<const unsigned char*>(in.data() + offset);
+            uint8_t opcode = p[0] & 0x0F;
+            bool masked = (p[1] & 0x80) != 0;
+            uint64_t length = p[1] & 0x7F;
+            size_t headerSize = 2;
+            if (length == 126) {
+                if (in.size() - offset < 4) break;
+                length = (uint64_t(p[2]) << 8) | p[3];
+                headerSize = 4;
+            } else if (length == 127) {
+                if (in.size() - offset < 10) break;
+                length = 0;
+                for (int i = 0; i < 8; i++) length = (length << 8) | p[2 + i];
+                headerSize = 10;
+            }
+            if (!masked || length > MAX_FRAME_PAYLOAD) {
+                quit(id);
+                break;
+            }
+            if (in.size() - offset < headerSize + 4 + length) break;
+
+            const unsigned char* mask = p + headerSize;
+            string payload(length, '\0');
+            for (size_t i = 0; i < length; i++) {
+                payload[i] = static_cast<char>(mask[4 + i] ^ mask[i % 4]);
+            }
+            offset += headerSize + 4 + length;
+
+            switch (opcode) {
+                case 0x0: case 0x1: case 0x2:
+                    for (char key : payload) {
+                        if (!handleKey(id, static_cast<unsigned char>(key))) break;
+                    }
+                    break;
+                case 0x8:
+                    quit(id);
+                    break;
+                case 0x9:
+                    frame = payload;
+                    queueFrame(session, 0xA);
+                    break;
+                default:
+                    break;
+            }
+        }
+        in.erase(0, offset);
+        if (in.empty() && in.capacity() > 256) string().swap(in);
+    }
+
+    void receive(uint32_t id) {
+        char buffer[4096];
+        while (sessions[id]) {
+            Session& session = *sessions[id];
+            long received = SocketApi::socketRecv(session.socket, buffer, sizeof(buffer));
+            if (received == SocketApi::WOULD_BLOCK) break;
+            if (received <= 0) {
+                closeSession(id);
+                return;
+            }
+            if (session.phase == SessionPhase::CLOSING) continue;
+
+            if (session.protocol == NetProtocol::TELNET) {
+                receiveTelnet(id, buffer, static_cast<size_t>(received));
+            } else {
+                session.inbound.append(buffer, static_cast<size_t>(received));
+                if (session.phase == SessionPhase::HANDSHAKE) receiveHandshake(id);
+                if (session.phase != SessionPhase::HANDSHAKE) receiveWebSocket(id);
+            }
+            queueFrame(session);
+        }
+        if (sessions[id]) flushSession(id);
+    }
+
+    void acceptAll(SocketHandle listener, NetProtocol protocol) {
+        while (true) {
+            SocketHandle socket = SocketApi::acceptFrom(listener);
+            if (socket == INVALID_SOCKET_HANDLE) return;
+            if (sessionCount >= serverConfig.maxSessions) {
+                SocketApi::closeSocket(socket);
+                continue;
+            }
+            openSession(socket, protocol);
+        }
+    }
+
+public:
+    GameServer(const GameConfig& cfg, const ServerConfig& serverCfg)
+        : config(cfg), serverConfig(serverCfg),
+          telnetListener(INVALID_SOCKET_HANDLE), webSocketListener(INVALID_SOCKET_HANDLE),
+          sessionCount(0), gamesStarted(0),
+          masterSeed(cfg.seed != 0 ? cfg.seed : BasicSnakeSimulation<BoardT>::makeSeed()),
+          cursorRow(-1), cursorCol(-1) {}
+
+    ~GameServer() {
+        for (uint32_t id = 0; id < sessions.size(); id++) {
+            if (sessions[id]) closeSession(id);
+        }
+        if (telnetListener != INVALID_SOCKET_HANDLE) SocketApi::closeSocket(telnetListener);
+        if (webSocketListener != INVALID_SOCKET_HANDLE) SocketApi::closeSocket(webSocketListener);
+    }
+
+    GameServer(const GameServer&) = delete;
+    GameServer& operator=(const GameServer&) = delete;
+
+    /**
+     * @brief Binds the configured listeners.
+     * @return False if the poller or any enabled listener failed
+     */
+    bool open() {
+        if (!poller.isValid()) return false;
+        if (serverConfig.telnetPort != 0) {
+            telnetListener = SocketApi::listenOn(serverConfig.bindAddress, serverConfig.telnetPort);
+            if (telnetListener == INVALID_SOCKET_HANDLE || !poller.add(telnetListener, TELNET_LISTENER)) {
+                return false;
+            }
+        }
+        if (serverConfig.webSocketPort != 0) {
+            webSocketListener = SocketApi::listenOn(serverConfig.bindAddress, serverConfig.webSocketPort);
+            if (webSocketListener == INVALID_SOCKET_HANDLE || !poller.add(webSocketListener, WEBSOCKET_LISTENER)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Runs the event loop until `stop` becomes true.
+     */
+    void run(const atomic<bool>& stop) {
+        vector<PollEvent> events;
+        timers.start(nowMs());
+
+        while (!stop.load(memory_order_relaxed)) {
+            // Bounded so a stop request is noticed even when idle
+            int timeout = timers.getTimeoutMs(nowMs());
+            if (timeout < 0 || timeout > 1000) timeout = 1000;
+            if (!poller.wait(events, timeout)) break;
+
+            for (const PollEvent& event : events) {
+                if (event.token == TELNET_LISTENER) {
+                    acceptAll(telnetListener, NetProtocol::TELNET);
+                    continue;
+                }
+                if (event.token == WEBSOCKET_LISTENER) {
+                    acceptAll(webSocketListener, NetProtocol::WEBSOCKET);
+                    continue;
+                }
+                uint32_t id = event.token - FIRST_SESSION_TOKEN;
+                if (id >= sessions.size() || !sessions[id]) continue;
+                if (event.readable) receive(id);
+                if (event.writable && sessions[id]) flushSession(id);
+            }
+
+            uint64_t now = nowMs();
+            timers.advance(now, [&](uint32_t id) {
+                if (sessions[id] && sessions[id]->phase == SessionPhase::PLAYING) tickSession(id, now);
+            });
+
+            freeIds.insert(freeIds.end(), retiredIds.begin(), retiredIds.end());
+            retiredIds.clear();
+        }
+    }
+
+    size_t getSessionCount() const { return sessionCount; }
+    uint64_t getGamesStarted() const { return gamesStarted; }
+};
+
+#endif // GAMESERVER_H
@@ -0,0 +1,354 @@
+// leaderboard.h
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/file.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+// ============================================================================
+// LEADERBOARD FILE FORMAT
+// ============================================================================
+//
+//   LeaderboardHeader                      fixed 32 bytes
+//   LeaderboardTable[LEADERBOARD_BOARDS]   one per board size, claimed in
+//                                          order of first use
+//
+// The file has a fixed size and is mapped whole, so opening it never parses
+// anything. Each table keeps its entries sorted by descending score, which
+// makes rank lookups a binary search. All writers hold an exclusive file lock
+// (flock / LockFileEx) and readers a shared one, so any number of processes
+// can use the same file.
+
+constexpr uint32_t LEADERBOARD_MAGIC = 0x4C4B4E53;    ///< "SNKL"
+constexpr uint16_t LEADERBOARD_VERSION = 1;
+constexpr uint32_t LEADERBOARD_TOP_K = 100;           ///< Entries kept per board size
+constexpr uint32_t LEADERBOARD_BOARDS = 64;           ///< Board sizes per file
+constexpr size_t LEADERBOARD_NAME_LENGTH = 32;        ///< Including the terminating NUL
+
+/**
+ * @brief One player's best score on one board size.
+ */
+struct LeaderboardEntry {
+    int32_t score;
+    uint32_t reserved;
+    int64_t achievedAt;                      ///< Unix time of the run
+    char player[LEADERBOARD_NAME_LENGTH];    ///< NUL-terminated
+};
+static_assert(sizeof(LeaderboardEntry) == 48, "LeaderboardEntry layout is part of the file format");
+
+/**
+ * @brief Top-K entries for one board size, sorted by descending score.
+ */
+struct LeaderboardTable {
+    int32_t rows;
+    int32_t cols;
+    uint32_t count;
+    uint32_t reserved;
+    LeaderboardEntry entries[LEADERBOARD_TOP_K];
+};
+
+struct LeaderboardHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t topK;
+    uint32_t boardCapacity;
+    uint32_t entrySize;
+    uint32_t boardsUsed;
+    uint32_t reserved[2];
+};
+static_assert(sizeof(LeaderboardHeader) == 32, "LeaderboardHeader layout is part of the file format");
+
+// ============================================================================
+// LEADERBOARD
+// ============================================================================
+
+/**
+ * @brief Shared per-player, per-board-size leaderboard backed by a mapped file.
+ *
+ * Ranks are 1-based; 0 means "not on the board". A player holds at most one
+ * entry per board size, their best.
+ */
+class Leaderboard {
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+#else
+    int fd = -1;
+#endif
+    uint8_t* base = nullptr;
+
+    static constexpr size_t FILE_SIZE = sizeof(LeaderboardHeader) + sizeof(LeaderboardTable) * LEADERBOARD_BOARDS;
+
+    LeaderboardHeader* header() const {
+        return reinterpret_cast<LeaderboardHeader*>(base);
+    }
+
+    LeaderboardTable* tables() const {
+        return reinterpret_cast<LeaderboardTable*>(base + sizeof(LeaderboardHeader));
+    }
+
+    /**
+     * @brief RAII file lock; exclusive for writers, shared for readers.
+     */
+    class FileLock {
+    private:
+        const Leaderboard& owner;
+    public:
+        FileLock(const Leaderboard& board, bool exclusive) : owner(board) {
+#ifdef _WIN32
+            OVERLAPPED overlapped = {};
+            LockFileEx(owner.file, exclusive ? LOCKFILE_EXCLUSIVE_LOCK : 0, 0, 1, 0, &overlapped);
+#else
+            while (flock(owner.fd, exclusive ? LOCK_EX : LOCK_SH) != 0 && errno == EINTR) {}
+#endif
+        }
+        ~FileLock() {
+#ifdef _WIN32
+            OVERLAPPED overlapped = {};
+            UnlockFileEx(owner.file, 0, 1, 0, &overlapped);
+#else
+            flock(owner.fd, LOCK_UN);
+#endif
+        }
+    };
+
+    LeaderboardTable* findTable(int rows, int cols) const {
+        LeaderboardTable* all = tables();
+        uint32_t used = header()->boardsUsed;
+        for (uint32_t i = 0; i < used && i < LEADERBOARD_BOARDS; i++) {
+            if (all[i].rows == rows && all[i].cols == cols) return &all[i];
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Number of entries scoring strictly more than `score`.
+     */
+    static uint32_t entriesAbove(const LeaderboardTable& table, int score) {
+        uint32_t lo = 0, hi = table.count;
+        while (lo < hi) {
+            uint32_t mid = (lo + hi) / 2;
+            if (table.entries[mid].score > score) lo = mid + 1;
+            else hi = mid;
+        }
+        return lo;
+    }
+
+    static void setPlayer(LeaderboardEntry& entry, const string& player) {
+        memset(entry.player, 0, sizeof(entry.player));
+        memcpy(entry.player, player.data(), min(player.size(), LEADERBOARD_NAME_LENGTH - 1));
+    }
+
+    static bool samePlayer(const LeaderboardEntry& entry, const string& player) {
+        size_t length = min(player.size(), LEADERBOARD_NAME_LENGTH - 1);
+        return strncmp(entry.player, player.data(), length) == 0 && entry.player[length] == '\0';
+    }
+
+    bool headerMatches() const {
+        const LeaderboardHeader* h = header();
+        return h->magic == LEADERBOARD_MAGIC && h->version == LEADERBOARD_VERSION &&
+               h->headerSize == sizeof(LeaderboardHeader) && h->topK == LEADERBOARD_TOP_K &&
+               h->boardCapacity == LEADERBOARD_BOARDS && h->entrySize == sizeof(LeaderboardEntry);
+    }
+
+    void writeHeader() {
+        LeaderboardHeader* h = header();
+        h->magic = LEADERBOARD_MAGIC;
+        h->version = LEADERBOARD_VERSION;
+        h->headerSize = sizeof(LeaderboardHeader);
+        h->topK = LEADERBOARD_TOP_K;
+        h->boardCapacity = LEADERBOARD_BOARDS;
+        h->entrySize = sizeof(LeaderboardEntry);
+        h->boardsUsed = 0;
+    }
+
+public:
+    Leaderboard() = default;
+    Leaderboard(const Leaderboard&) = delete;
+    Leaderboard& operator=(const Leaderboard&) = delete;
+
+    ~Leaderboard() {
+        close();
+    }
+
+    /**
+     * @brief Opens or creates the leaderboard file and maps it.
+     * @param path File to use
+     * @return False if the file cannot be mapped or has another layout
+     */
+    bool open(const string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                           nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+
+        bool created = false;
+        {
+            FileLock lock(*this, true);
+            LARGE_INTEGER size = {};
+            GetFileSizeEx(file, &size);
+            if (size.QuadPart == 0) {
+                LARGE_INTEGER target;
+                target.QuadPart = FILE_SIZE;
+                SetFilePointerEx(file, target, nullptr, FILE_BEGIN);
+                SetEndOfFile(file);
+                created = true;
+            } else if (size.QuadPart != static_cast<LONGLONG>(FILE_SIZE)) {
+                CloseHandle(file);
+                file = INVALID_HANDLE_VALUE;
+                return false;
+            }
+
+            mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, 0, 0, nullptr);
+            if (mapping) base = static_cast<uint8_t*>(MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, FILE_SIZE));
+            if (base && created) writeHeader();
+        }
+#else
+        fd = ::open(path.c_str(), O_RDWR | O_CREAT, 0664);
+        if (fd < 0) return false;
+
+        {
+            FileLock lock(*this, true);
+            struct stat info;
+            bool created = false;
+            bool statOk = fstat(fd, &info) == 0;
+            if (statOk && info.st_size == 0) {
+                created = ftruncate(fd, FILE_SIZE) == 0;
+            } else if (!statOk || info.st_size != static_cast<off_t>(FILE_SIZE)) {
+                ::close(fd);
+                fd = -1;
+                return false;
+            }
+
+            void* mapped = mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (mapped != MAP_FAILED) base = static_cast<uint8_t*>(mapped);
+            if (base && created) writeHeader();
+        }
+#endif
+        if (!base || !headerMatches()) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (base) UnmapViewOfFile(base);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (base) munmap(base, FILE_SIZE);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        base = nullptr;
+    }
+
+    bool isOpen() const { return base != nullptr; }
+
+    /**
+     * @brief Records a finished run, keeping only each player's best.
+     * @param rows Board rows
+     * @param cols Board columns
+     * @param player Player name (truncated to 31 bytes)
+     * @param score Final score
+     * @return The player's rank on this board size afterwards, 0 if off the board
+     */
+    uint32_t submit(int rows, int cols, const string& player, int score) {
+        if (!base) return 0;
+        FileLock lock(*this, true);
+
+        LeaderboardTable* table = findTable(rows, cols);
+        if (!table) {
+            LeaderboardHeader* h = header();
+            if (h->boardsUsed >= LEADERBOARD_BOARDS) return 0;
+            table = &tables()[h->boardsUsed];
+            memset(table, 0, sizeof(*table));
+            table->rows = rows;
+            table->cols = cols;
+            h->boardsUsed++;
+        }
+
+        // A player's existing entry is replaced only by a better score
+        uint32_t existing = table->count;
+        for (uint32_t i = 0; i < table->count; i++) {
+            if (samePlayer(table->entries[i], player)) {
+                existing = i;
+                break;
+            }
+        }
+        if (existing < table->count) {
+            if (table->entries[existing].score >= score) return existing + 1;
+            memmove(&table->entries[existing], &table->entries[existing + 1],
+                    (table->count - existing - 1) * sizeof(LeaderboardEntry));
+            table->count--;
+        }
+
+        // Ties keep the earlier run ahead
+        uint32_t position = entriesAbove(*table, score - 1);
+        if (position >= LEADERBOARD_TOP_K) return 0;
+
+        uint32_t moved = min(table->count, LEADERBOARD_TOP_K - 1) - position;
+        memmove(&table->entries[position + 1], &table->entries[position], moved * sizeof(LeaderboardEntry));
+
+        LeaderboardEntry& entry = table->entries[position];
+        entry.score = score;
+        entry.reserved = 0;
+        entry.achievedAt = static_cast<int64_t>(time(nullptr));
+        setPlayer(entry, player);
+        table->count = min(table->count + 1, LEADERBOARD_TOP_K);
+        return position + 1;
+    }
+
+    /**
+     * @brief Rank a score would take on a board size, without recording it.
+     * @return 1-based rank, 0 if it would not make the top K
+     */
+    uint32_t rankOf(int rows, int cols, int score) const {
+        if (!base) return 0;
+        FileLock lock(*this, false);
+        const LeaderboardTable* table = findTable(rows, cols);
+        uint32_t position = table ? entriesAbove(*table, score) : 0;
+        return position < LEADERBOARD_TOP_K ? position + 1 : 0;
+    }
+
+    /**
+     * @brief Copies the best `limit` entries for a board size.
+     */
+    vector<LeaderboardEntry> top(int rows, int cols, size_t limit) const {
+        vector<LeaderboardEntry> result;
+        if (!base) return result;
+        FileLock lock(*this, false);
+        const LeaderboardTable* table = findTable(rows, cols);
+        if (table) {
+            size_t count = min<size_t>(table->count, limit);
+            result.assign(table->entries, table->entries + count);
+        }
+        return result;
+    }
+};
+
+#endif // LEADERBOARD_H
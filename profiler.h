@@ -0,0 +1,459 @@
+// profiler.h
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <array>
+#include <algorithm>
+#include <thread>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include <intrin.h>
+    #define SNAKE_PROFILE_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+    #define SNAKE_PROFILE_HAS_TSC 1
+#endif
+
+using namespace std;
+
+// ============================================================================
+// PHASES AND COUNTERS
+// ============================================================================
+
+/**
+ * @brief Timed sections of a tick and a frame.
+ */
+enum ProfilePhase {
+    PHASE_TICK = 0,          ///< Whole SnakeGameLogic::update()
+    PHASE_INPUT = 1,         ///< DirectionController::processInput()
+    PHASE_COLLISION = 2,     ///< Wall and self-collision checks
+    PHASE_FOOD = 3,          ///< FoodManager::placeRandom()
+    PHASE_PUBLISH = 4,       ///< StatePublisher::publishTick()
+    PHASE_RENDER = 5,        ///< GameRenderer::updateGameBoard()
+    PHASE_SCORE_WRITE = 6,   ///< High score file write (background thread)
+    PHASE_COUNT = 7
+};
+
+/**
+ * @brief Event counts kept next to the timings.
+ */
+enum ProfileCounter {
+    COUNTER_FRAMES = 0,          ///< Frames written to the terminal
+    COUNTER_FRAME_BYTES = 1,     ///< Bytes in those frames
+    COUNTER_FRAMES_SKIPPED = 2,  ///< Published states the renderer never drew
+    COUNTER_OUTPUT_STALLS = 3,   ///< Terminal writes that hit EAGAIN
+    COUNTER_COUNT = 4
+};
+
+inline const char* profilePhaseName(int phase) {
+    static const char* const names[PHASE_COUNT] = {
+        "tick", "input", "collision", "food", "publish", "render", "score_write"
+    };
+    return phase >= 0 && phase < PHASE_COUNT ? names[phase] : "unknown";
+}
+
+inline const char* profileCounterName(int counter) {
+    static const char* const names[COUNTER_COUNT] = {"frames", "frame_bytes", "frames_skipped", "output_stalls"};
+    return counter >= 0 && counter < COUNTER_COUNT ? names[counter] : "unknown";
+}
+
+// ============================================================================
+// CLOCK
+// ============================================================================
+
+/**
+ * @brief Cheapest monotonic timestamp available: the TSC on x86, else steady_clock.
+ *
+ * Timings are kept in raw ticks; Profiler converts them to nanoseconds
+ * when a report is taken, calibrating the TSC against steady_clock over
+ * the whole run.
+ */
+class ProfileClock {
+public:
+    static uint64_t now() {
+#ifdef SNAKE_PROFILE_HAS_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static constexpr bool usesTsc() {
+#ifdef SNAKE_PROFILE_HAS_TSC
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+// ============================================================================
+// HISTOGRAMS
+// ============================================================================
+
+/**
+ * @brief Log-linear latency histogram in the style of HdrHistogram.
+ *
+ * Values below 16 get a bucket each; above that every power of two is
+ * split into 16 buckets, so any percentile is within 1/16 (6.25%) of the
+ * true value from one tick up to 2^48 ticks. One thread records and any
+ * thread may read: bucket counts are atomics written with plain relaxed
+ * stores, so recording needs no read-modify-write.
+ */
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BITS = 4;
+    static constexpr int SUB_COUNT = 1 << SUB_BITS;
+    static constexpr int MAX_EXPONENT = 47;
+    static constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_COUNT;
+
+    static int bucketOf(uint64_t value) {
+        if (value < static_cast<uint64_t>(SUB_COUNT)) return static_cast<int>(value);
+        int exponent = 63 - countlZero(value);
+        if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+        int sub = static_cast<int>(value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+        return (exponent - SUB_BITS + 1) * SUB_COUNT + sub;
+    }
+
+    /// Smallest value in a bucket
+    static uint64_t bucketLow(int bucket) {
+        if (bucket < SUB_COUNT) return static_cast<uint64_t>(bucket);
+        int exponent = bucket / SUB_COUNT + SUB_BITS - 1;
+        uint64_t sub = static_cast<uint64_t>(bucket % SUB_COUNT);
+        return (SUB_COUNT + sub) << (exponent - SUB_BITS);
+    }
+
+    /// Width of a bucket
+    static uint64_t bucketWidth(int bucket) {
+        if (bucket < SUB_COUNT) return 1;
+        return uint64_t(1) << (bucket / SUB_COUNT - 1);
+    }
+
+private:
+    array<atomic<uint64_t>, BUCKET_COUNT> buckets;
+    atomic<uint64_t> count;
+    atomic<uint64_t> total;
+    atomic<uint64_t> maximum;
+
+    static int countlZero(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_clzll(value);
+#else
+        int zeros = 0;
+        for (uint64_t bit = uint64_t(1) << 63; !(value & bit); bit >>= 1) zeros++;
+        return zeros;
+#endif
+    }
+
+    static void bump(atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(memory_order_relaxed) + amount, memory_order_relaxed);
+    }
+
+public:
+    LatencyHistogram() : count(0), total(0), maximum(0) {
+        for (atomic<uint64_t>& bucket : buckets) bucket.store(0, memory_order_relaxed);
+    }
+
+    /// Owner thread only
+    void record(uint64_t ticks) {
+        bump(buckets[bucketOf(ticks)], 1);
+        bump(count, 1);
+        bump(total, ticks);
+        if (ticks > maximum.load(memory_order_relaxed)) maximum.store(ticks, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Adds this histogram into plain totals (safe from any thread).
+     */
+    void addTo(uint64_t* bucketTotals, uint64_t& countTotal, uint64_t& tickTotal, uint64_t& tickMax) const {
+        for (int i = 0; i < BUCKET_COUNT; i++) {
+            bucketTotals[i] += buckets[i].load(memory_order_relaxed);
+        }
+        countTotal += count.load(memory_order_relaxed);
+        tickTotal += total.load(memory_order_relaxed);
+        tickMax = max(tickMax, maximum.load(memory_order_relaxed));
+    }
+};
+
+// ============================================================================
+// REPORTS
+// ============================================================================
+
+/**
+ * @brief Latency summary of one phase, in nanoseconds.
+ */
+struct PhaseSummary {
+    uint64_t count = 0;
+    double meanNs = 0;
+    double p50Ns = 0;
+    double p90Ns = 0;
+    double p99Ns = 0;
+    double maxNs = 0;
+};
+
+/**
+ * @brief Everything the profiler knows at one moment, across all threads.
+ */
+struct ProfileReport {
+    bool enabled = false;
+    double seconds = 0;                      ///< Since the profiler started
+    PhaseSummary phases[PHASE_COUNT];
+    uint64_t counters[COUNTER_COUNT] = {};
+
+    /// "850ns", "12.3us", "4.56ms"
+    static string formatDuration(double ns) {
+        char text[32];
+        if (ns < 1e3) snprintf(text, sizeof(text), "%.0fns", ns);
+        else if (ns < 1e6) snprintf(text, sizeof(text), "%.1fus", ns / 1e3);
+        else snprintf(text, sizeof(text), "%.2fms", ns / 1e6);
+        return text;
+    }
+
+    /**
+     * @brief One-line summary for the in-game stats overlay.
+     */
+    string statsLine() const {
+        if (!enabled) return "  stats: profiling not compiled in (build with -DSNAKE_PROFILE)";
+        const PhaseSummary& tick = phases[PHASE_TICK];
+        const PhaseSummary& render = phases[PHASE_RENDER];
+        uint64_t frames = counters[COUNTER_FRAMES];
+        uint64_t bytesPerFrame = frames ? counters[COUNTER_FRAME_BYTES] / frames : 0;
+        return "  tick p50 " + formatDuration(tick.p50Ns) + " p99 " + formatDuration(tick.p99Ns) +
+               "  |  render p50 " + formatDuration(render.p50Ns) + " p99 " + formatDuration(render.p99Ns) +
+               "  |  " + to_string(bytesPerFrame) + " B/frame  |  " +
+               to_string(counters[COUNTER_FRAMES_SKIPPED]) + " skipped";
+    }
+
+    string toJson() const {
+        char number[64];
+        string json = "{\"enabled\": ";
+        json += enabled ? "true" : "false";
+        json += ", \"clock\": \"";
+        json += ProfileClock::usesTsc() ? "tsc" : "steady_clock";
+        snprintf(number, sizeof(number), "\", \"seconds\": %.3f", seconds);
+        json += number;
+
+        json += ", \"phases\": {";
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            const PhaseSummary& phase = phases[p];
+            json += p ? ", \"" : "\"";
+            json += profilePhaseName(p);
+            json += "\": {\"count\": " + to_string(phase.count);
+            snprintf(number, sizeof(number), ", \"mean_ns\": %.1f", phase.meanNs);
+            json += number;
+            snprintf(number, sizeof(number), ", \"p50_ns\": %.1f", phase.p50Ns);
+            json += number;
+            snprintf(number, sizeof(number), ", \"p90_ns\": %.1f", phase.p90Ns);
+            json += number;
+            snprintf(number, sizeof(number), ", \"p99_ns\": %.1f", phase.p99Ns);
+            json += number;
+            snprintf(number, sizeof(number), ", \"max_ns\": %.1f}", phase.maxNs);
+            json += number;
+        }
+
+        json += "}, \"counters\": {";
+        for (int c = 0; c < COUNTER_COUNT; c++) {
+            json += c ? ", \"" : "\"";
+            json += profileCounterName(c);
+            json += "\": " + to_string(counters[c]);
+        }
+        json += "}}\n";
+        return json;
+    }
+};
+
+// ============================================================================
+// PROFILER
+// ============================================================================
+
+/**
+ * @brief Process-wide registry of per-thread histograms.
+ *
+ * Each thread that records claims a slot on first use and releases it when
+ * it exits; a later thread may take the slot over and keep adding to it,
+ * so totals survive short-lived threads (one renderer per game). Slots are
+ * never freed, which lets report() read them while threads record. Up to
+ * MAX_THREADS threads record at once; samples from any beyond that are
+ * dropped.
+ */
+class Profiler {
+public:
+    static constexpr int MAX_THREADS = 64;
+
+private:
+    struct alignas(64) ThreadProfile {
+        LatencyHistogram phases[PHASE_COUNT];
+        atomic<uint64_t> counters[COUNTER_COUNT];
+        atomic<bool> inUse;
+
+        ThreadProfile() : inUse(true) {
+            for (atomic<uint64_t>& counter : counters) counter.store(0, memory_order_relaxed);
+        }
+    };
+
+    struct LocalSlot {
+        ThreadProfile* profile = nullptr;
+        bool claimed = false;
+
+        ~LocalSlot() {
+            if (profile) profile->inUse.store(false, memory_order_release);
+        }
+    };
+
+    array<atomic<ThreadProfile*>, MAX_THREADS> slots;
+    uint64_t startTicks;
+    chrono::steady_clock::time_point startTime;
+
+    Profiler() : startTicks(ProfileClock::now()), startTime(chrono::steady_clock::now()) {
+        for (atomic<ThreadProfile*>& slot : slots) slot.store(nullptr, memory_order_relaxed);
+    }
+
+    ~Profiler() {
+        for (atomic<ThreadProfile*>& slot : slots) delete slot.load(memory_order_relaxed);
+    }
+
+    ThreadProfile* claim() {
+        for (atomic<ThreadProfile*>& slot : slots) {
+            ThreadProfile* profile = slot.load(memory_order_acquire);
+            if (!profile) {
+                ThreadProfile* fresh = new ThreadProfile();
+                if (slot.compare_exchange_strong(profile, fresh, memory_order_acq_rel)) return fresh;
+                delete fresh;
+            }
+            bool idle = false;
+            if (profile->inUse.compare_exchange_strong(idle, true, memory_order_acq_rel)) return profile;
+        }
+        return nullptr;
+    }
+
+    static ThreadProfile* local() {
+        thread_local LocalSlot slot;
+        if (!slot.claimed) {
+            slot.claimed = true;
+            slot.profile = instance().claim();
+        }
+        return slot.profile;
+    }
+
+    static double percentile(const uint64_t* buckets, uint64_t count, double fraction) {
+        uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(fraction * count + 0.5));
+        uint64_t seen = 0;
+        for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            seen += buckets[i];
+            if (seen >= rank) {
+                return LatencyHistogram::bucketLow(i) + (LatencyHistogram::bucketWidth(i) - 1) / 2.0;
+            }
+        }
+        return 0;
+    }
+
+public:
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    static void record(ProfilePhase phase, uint64_t ticks) {
+        if (ThreadProfile* profile = local()) profile->phases[phase].record(ticks);
+    }
+
+    static void count(ProfileCounter counter, uint64_t amount) {
+        if (ThreadProfile* profile = local()) {
+            atomic<uint64_t>& value = profile->counters[counter];
+            value.store(value.load(memory_order_relaxed) + amount, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Merges every thread's histograms into a report.
+     */
+    ProfileReport report() const {
+        ProfileReport result;
+#ifdef SNAKE_PROFILE
+        result.enabled = true;
+#endif
+        // Nanoseconds per clock tick over the run so far (exactly 1 without a TSC)
+        uint64_t nowTicks = ProfileClock::now();
+        double elapsedNs = chrono::duration<double, nano>(chrono::steady_clock::now() - startTime).count();
+        result.seconds = elapsedNs / 1e9;
+        double nsPerTick = 1.0;
+        if (ProfileClock::usesTsc() && nowTicks > startTicks && elapsedNs > 1e6) {
+            nsPerTick = elapsedNs / static_cast<double>(nowTicks - startTicks);
+        }
+
+        static thread_local array<uint64_t, LatencyHistogram::BUCKET_COUNT> buckets;
+        for (int p = 0; p < PHASE_COUNT; p++) {
+            buckets.fill(0);
+            uint64_t count = 0, total = 0, maximum = 0;
+            for (const atomic<ThreadProfile*>& slot : slots) {
+                if (const ThreadProfile* profile = slot.load(memory_order_acquire)) {
+                    profile->phases[p].addTo(buckets.data(), count, total, maximum);
+                }
+            }
+
+            PhaseSummary& summary = result.phases[p];
+            summary.count = count;
+            if (count == 0) continue;
+            summary.meanNs = static_cast<double>(total) / count * nsPerTick;
+            summary.p50Ns = percentile(buckets.data(), count, 0.50) * nsPerTick;
+            summary.p90Ns = percentile(buckets.data(), count, 0.90) * nsPerTick;
+            summary.p99Ns = percentile(buckets.data(), count, 0.99) * nsPerTick;
+            summary.maxNs = static_cast<double>(maximum) * nsPerTick;
+            summary.p50Ns = min(summary.p50Ns, summary.maxNs);
+            summary.p90Ns = min(summary.p90Ns, summary.maxNs);
+            summary.p99Ns = min(summary.p99Ns, summary.maxNs);
+        }
+
+        for (const atomic<ThreadProfile*>& slot : slots) {
+            if (const ThreadProfile* profile = slot.load(memory_order_acquire)) {
+                for (int c = 0; c < COUNTER_COUNT; c++) {
+                    result.counters[c] += profile->counters[c].load(memory_order_relaxed);
+                }
+            }
+        }
+        return result;
+    }
+};
+
+/**
+ * @brief Records the time from construction to destruction under a phase.
+ */
+class ScopedPhaseTimer {
+private:
+    ProfilePhase phase;
+    uint64_t start;
+
+public:
+    explicit ScopedPhaseTimer(ProfilePhase timedPhase) : phase(timedPhase), start(ProfileClock::now()) {}
+    ~ScopedPhaseTimer() { Profiler::record(phase, ProfileClock::now() - start); }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+};
+
+// ============================================================================
+// INSTRUMENTATION MACROS
+// ============================================================================
+
+// Build with -DSNAKE_PROFILE to record; otherwise the macros expand to
+// nothing and instrumented code is exactly what it would be without them.
+#ifdef SNAKE_PROFILE
+    #define SNAKE_PROFILE_CONCAT_INNER(a, b) a##b
+    #define SNAKE_PROFILE_CONCAT(a, b) SNAKE_PROFILE_CONCAT_INNER(a, b)
+    #define SNAKE_PROFILE_SCOPE(phase) ScopedPhaseTimer SNAKE_PROFILE_CONCAT(profileScope, __LINE__)(phase)
+    #define SNAKE_PROFILE_COUNT(counter, amount) Profiler::count(counter, amount)
+#else
+    #define SNAKE_PROFILE_SCOPE(phase) ((void)0)
+    #define SNAKE_PROFILE_COUNT(counter, amount) ((void)0)
+#endif
+
+#endif // PROFILER_H
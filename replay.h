@@ -0,0 +1,336 @@
+// replay.h
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "gameLogic.h"
+#include <cstdio>
+#include <string>
+#include <thread>
+
+// ============================================================================
+// REPLAY FILE FORMAT
+// ============================================================================
+//
+//   ReplayHeader                   fixed 36 bytes, little-endian
+//   uint8_t direction[ticks]       direction in effect after each update()
+//   ReplayTrailer (optional)       written by finish(); absent if the game
+//                                  was cut short
+//
+// Direction bytes are 0-4, so the trailer magic can never be mistaken for
+// an input byte.
+
+constexpr uint32_t REPLAY_MAGIC = 0x524B4E53;          ///< "SNKR"
+constexpr uint32_t REPLAY_TRAILER_MAGIC = 0x454B4E53;  ///< "SNKE"
+constexpr uint16_t REPLAY_VERSION = 1;
+
+/**
+ * @brief Everything needed to restart the recorded game bit-for-bit.
+ */
+struct ReplayHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    int32_t rows;
+    int32_t cols;
+    int32_t startingLength;
+    int32_t pointsPerFood;
+    int32_t tickMilliseconds;        ///< Tick length of the original session
+    uint8_t initialDirection;
+    uint8_t reserved[3];
+    uint32_t seed;
+};
+static_assert(sizeof(ReplayHeader) == 36, "ReplayHeader layout is part of the file format");
+
+/**
+ * @brief Final outcome, used to verify a replay reproduces the original game.
+ */
+struct ReplayTrailer {
+    uint32_t magic;
+    int32_t finalScore;
+    uint64_t ticks;
+};
+static_assert(sizeof(ReplayTrailer) == 16, "ReplayTrailer layout is part of the file format");
+
+// ============================================================================
+// BUFFERED APPENDER
+// ============================================================================
+
+/**
+ * @brief Append-only file writer that batches small writes into one buffer.
+ */
+class BufferedAppender {
+private:
+    FILE* file;
+    vector<uint8_t> buffer;
+    size_t used;
+
+public:
+    explicit BufferedAppender(size_t capacity = 64 * 1024)
+        : file(nullptr), buffer(capacity), used(0) {}
+
+    BufferedAppender(const BufferedAppender&) = delete;
+    BufferedAppender& operator=(const BufferedAppender&) = delete;
+
+    ~BufferedAppender() {
+        close();
+    }
+
+    bool open(const string& path) {
+        close();
+        file = fopen(path.c_str(), "wb");
+        return file != nullptr;
+    }
+
+    bool isOpen() const { return file != nullptr; }
+
+    void append(const void* data, size_t size) {
+        if (!file) return;
+        if (used + size > buffer.size()) {
+            flush();
+            if (size > buffer.size()) {
+                fwrite(data, 1, size, file);
+                return;
+            }
+        }
+        memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+
+    void appendByte(uint8_t value) {
+        if (used == buffer.size()) flush();
+        buffer[used++] = value;
+    }
+
+    void flush() {
+        if (file && used > 0) {
+            fwrite(buffer.data(), 1, used, file);
+            fflush(file);
+        }
+        used = 0;
+    }
+
+    void close() {
+        if (!file) return;
+        flush();
+        fclose(file);
+        file = nullptr;
+    }
+};
+
+// ============================================================================
+// RECORDER
+// ============================================================================
+
+/**
+ * @brief Records a game as its seed plus one direction byte per tick.
+ *
+ * Call start() after initializeBoard() and record() after every update()
+ * on the thread that runs the game logic.
+ */
+class ReplayRecorder {
+private:
+    BufferedAppender output;
+    uint64_t ticks;
+
+public:
+    ReplayRecorder() : ticks(0) {}
+
+    /**
+     * @brief Opens the log and writes the header for the game just initialized.
+     * @param path File to create
+     * @param game Freshly initialized game
+     * @param startingLength Starting length passed to initializeBoard()
+     * @param pointsPerFood Points per food passed to initializeBoard()
+     * @param initialDirection Direction passed to initializeBoard()
+     * @param tickMilliseconds Session tick length, used for real-time playback
+     * @return True if the file could be created
+     */
+    template<typename Game>
+    bool start(const string& path, const Game& game, int startingLength,
+               int pointsPerFood, Direction initialDirection, int tickMilliseconds) {
+        if (!output.open(path)) return false;
+
+        const auto& simulation = game.getSimulation();
+        ReplayHeader header = {};
+        header.magic = REPLAY_MAGIC;
+        header.version = REPLAY_VERSION;
+        header.headerSize = sizeof(ReplayHeader);
+        header.rows = simulation.getBoard().getRows();
+        header.cols = simulation.getBoard().getCols();
+        header.startingLength = startingLength;
+        header.pointsPerFood = pointsPerFood;
+        header.tickMilliseconds = tickMilliseconds;
+        header.initialDirection = static_cast<uint8_t>(initialDirection);
+        header.seed = simulation.getSeed();
+        output.append(&header, sizeof(header));
+        ticks = 0;
+        return true;
+    }
+
+    /**
+     * @brief Logs the direction the last update() moved in.
+     * @param game Game that was just updated
+     */
+    template<typename Game>
+    void record(const Game& game) {
+        if (!output.isOpen()) return;
+        output.appendByte(static_cast<uint8_t>(game.getSimulation().getDirection()));
+        ticks++;
+    }
+
+    /**
+     * @brief Writes the trailer and closes the log.
+     * @param game Game whose outcome is recorded
+     */
+    template<typename Game>
+    void finish(const Game& game) {
+        if (!output.isOpen()) return;
+        ReplayTrailer trailer = {REPLAY_TRAILER_MAGIC, game.getSimulation().getScore(), ticks};
+        output.append(&trailer, sizeof(trailer));
+        output.close();
+    }
+
+    bool isRecording() const { return output.isOpen(); }
+};
+
+// ============================================================================
+// PLAYER
+// ============================================================================
+
+/**
+ * @brief How fast a replay is fed through update().
+ */
+enum class PlaybackMode {
+    REAL_TIME,          ///< Original tick length
+    SPEED_MULTIPLIER,   ///< Original tick length divided by a factor
+    UNTHROTTLED         ///< No waiting at all
+};
+
+/**
+ * @brief Outcome of a playback run.
+ */
+struct ReplayResult {
+    uint64_t ticks;
+    int finalScore;
+    bool gameOver;
+    bool hasTrailer;    ///< Whether the log recorded an expected outcome
+    bool matches;       ///< Outcome equals the trailer (true when there is none)
+};
+
+/**
+ * @brief Loads a replay log and feeds it back through SnakeGameLogic::update().
+ */
+class ReplayPlayer {
+private:
+    ReplayHeader header;
+    ReplayTrailer trailer;
+    bool hasTrailer;
+    vector<uint8_t> inputs;
+
+public:
+    ReplayPlayer() : header{}, trailer{}, hasTrailer(false) {}
+
+    /**
+     * @brief Reads a replay file into memory.
+     * @param path File to read
+     * @return True if the file is a valid replay log
+     */
+    bool load(const string& path) {
+        FILE* file = fopen(path.c_str(), "rb");
+        if (!file) return false;
+
+        vector<uint8_t> data;
+        uint8_t chunk[64 * 1024];
+        size_t got;
+        while ((got = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            data.insert(data.end(), chunk, chunk + got);
+        }
+        fclose(file);
+
+        if (data.size() < sizeof(ReplayHeader)) return false;
+        memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION ||
+            header.headerSize < sizeof(ReplayHeader) || header.headerSize > data.size()) {
+            return false;
+        }
+
+        size_t end = data.size();
+        hasTrailer = false;
+        if (end - header.headerSize >= sizeof(ReplayTrailer)) {
+            memcpy(&trailer, data.data() + end - sizeof(ReplayTrailer), sizeof(trailer));
+            if (trailer.magic == REPLAY_TRAILER_MAGIC) {
+                hasTrailer = true;
+                end -= sizeof(ReplayTrailer);
+            }
+        }
+
+        inputs.assign(data.begin() + header.headerSize, data.begin() + end);
+        return true;
+    }
+
+    /**
+     * @brief Restarts `game` from the recorded seed and settings.
+     */
+    template<typename Game>
+    void initialize(Game& game) const {
+        game.initializeBoard(header.rows, header.cols, header.startingLength,
+                             header.pointsPerFood, static_cast<Direction>(header.initialDirection),
+                             header.seed);
+    }
+
+    /**
+     * @brief Initializes `game` and plays the whole log through update().
+     * @param game Game to drive (its publishing settings are left as configured)
+     * @param mode Pacing mode
+     * @param speed Speed factor for SPEED_MULTIPLIER
+     * @param onTick Called after each update() with the game; return false to stop
+     * @return Outcome of the run
+     */
+    template<typename Game, typename OnTick>
+    ReplayResult play(Game& game, PlaybackMode mode, double speed, OnTick&& onTick) const {
+        initialize(game);
+
+        chrono::nanoseconds tickLength(0);
+        if (mode == PlaybackMode::REAL_TIME) {
+            tickLength = chrono::milliseconds(header.tickMilliseconds);
+        } else if (mode == PlaybackMode::SPEED_MULTIPLIER && speed > 0) {
+            tickLength = chrono::nanoseconds(static_cast<int64_t>(header.tickMilliseconds * 1e6 / speed));
+        }
+
+        ReplayResult result = {0, 0, false, hasTrailer, true};
+        auto deadline = chrono::steady_clock::now();
+
+        for (uint8_t input : inputs) {
+            if (tickLength.count() > 0) {
+                deadline += tickLength;
+                this_thread::sleep_until(deadline);
+            }
+
+            game.setDirection(static_cast<Direction>(input));
+            bool alive = game.update();
+            result.ticks++;
+
+            if (!onTick(game) || !alive) break;
+        }
+
+        result.finalScore = game.getSimulation().getScore();
+        result.gameOver = game.getSimulation().isGameOver();
+        if (hasTrailer) {
+            result.matches = result.finalScore == trailer.finalScore && result.ticks == trailer.ticks;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Plays the log with no pacing and no per-tick callback.
+     */
+    template<typename Game>
+    ReplayResult play(Game& game) const {
+        return play(game, PlaybackMode::UNTHROTTLED, 1.0, [](const Game&) { return true; });
+    }
+
+    const ReplayHeader& getHeader() const { return header; }
+    uint64_t getTickCount() const { return inputs.size(); }
+};
+
+#endif // REPLAY_H
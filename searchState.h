@@ -0,0 +1,410 @@
+// searchState.h
+#ifndef SEARCHSTATE_H
+#define SEARCHSTATE_H
+
+#include <new>
+
+#include "simRunner.h"
+
+// ============================================================================
+// SEARCH STATE
+// ============================================================================
+
+/**
+ * @brief Where food comes from when a searched move eats.
+ */
+enum SearchFoodMode {
+    SEARCH_FOOD_STREAM = 0,          ///< A private random stream; undo() rewinds it
+    SEARCH_FOOD_DETERMINIZED = 1,    ///< Fixed by (seed, tick): every branch sees the same draw at the same depth
+    SEARCH_FOOD_CHANCE = 2           ///< Left to the caller: needsFood(), then placeFood() (expectimax chance nodes)
+};
+
+/**
+ * @brief A game position for tree search: make/unmake moves without copying.
+ *
+ * Holds only what the rules need - the byte grid, the free-cell set, the
+ * body ring and the scalars - in flat arrays from a ScratchArena, with no
+ * bit planes, publisher or input queue. apply() plays one tick with the
+ * same rules as BasicSnakeSimulation::step() and logs every cell write;
+ * undo() replays the log of the last move backwards in O(1). clone()
+ * copies the arrays into another arena for a new branch.
+ *
+ * Free-cell writes mirror Board exactly, so a state taken from a live game
+ * keeps its free-cell order; only the food draws differ, since the game's
+ * mt19937 cannot be rewound. States live in their arena and are only
+ * valid until it is reset.
+ */
+class SearchState {
+public:
+    struct CellWrite {
+        int32_t index;
+        int32_t slot;                // Free-list slot the cell left, if it was EMPTY
+        uint8_t previous;
+    };
+
+    struct Undo {
+        CellWrite writes[4];         // Food eaten, tail, head, food placed
+        uint8_t writeCount;
+        uint8_t direction;
+        uint8_t gameOver;
+        uint8_t gameOverCause;
+        uint8_t needsFood;
+        uint32_t headSlot;
+        uint32_t length;
+        uint32_t overwritten;        // Ring slot the new head took
+        int32_t growthPending;
+        int32_t food;
+        int32_t score;
+        uint64_t tick;
+        uint64_t random;
+    };
+
+private:
+    uint8_t* cells;
+    int32_t* freeCells;
+    int32_t* freeSlot;
+    uint32_t* ring;
+    Undo* log;
+
+    int32_t rows;
+    int32_t cols;
+    int32_t cellCount;
+    int32_t freeCount;
+    uint32_t headSlot;
+    uint32_t length;
+    int32_t growthPending;
+    int32_t food;
+    int32_t score;
+    int32_t pointsPerFood;
+    uint64_t tick;
+    Direction direction;
+    bool gameOver;
+    bool needsFood;
+    GameOverCause gameOverCause;
+    SearchFoodMode foodMode;
+    uint64_t random;                 // Stream state, or the seed when determinized
+    uint32_t depth;
+    uint32_t maxDepth;
+
+    SearchState() = default;
+
+    /**
+     * @brief Allocates the arrays for a board from an arena; contents are undefined.
+     */
+    static SearchState* allocate(ScratchArena& arena, int32_t cellCount, uint32_t maxDepth) {
+        SearchState* state = new (arena.allocate<SearchState>(1)) SearchState();
+        state->cellCount = cellCount;
+        state->cells = arena.allocate<uint8_t>(static_cast<size_t>(cellCount));
+        state->freeCells = arena.allocate<int32_t>(static_cast<size_t>(cellCount));
+        state->freeSlot = arena.allocate<int32_t>(static_cast<size_t>(cellCount));
+        state->ring = arena.allocate<uint32_t>(static_cast<size_t>(cellCount));
+        state->log = arena.allocate<Undo>(max(maxDepth, 1u));
+        state->maxDepth = maxDepth;
+        state->depth = 0;
+        return state;
+    }
+
+    uint32_t slotAt(uint32_t i) const {
+        uint32_t slot = headSlot + i;
+        return slot >= static_cast<uint32_t>(cellCount) ? slot - static_cast<uint32_t>(cellCount) : slot;
+    }
+
+    /**
+     * @brief Board::setCell() on the grid and free set, logged for undo.
+     */
+    void setCell(Undo& record, int32_t index, uint8_t cellType) {
+        uint8_t previous = cells[index];
+        if (previous == cellType) return;
+        CellWrite& write = record.writes[record.writeCount++];
+        write.index = index;
+        write.previous = previous;
+        write.slot = -1;
+        cells[index] = cellType;
+
+        if (previous == EMPTY) {
+            int32_t slot = freeSlot[index];
+            int32_t last = freeCells[--freeCount];
+            freeCells[slot] = last;
+            freeSlot[last] = slot;
+            freeSlot[index] = -1;
+            write.slot = slot;
+        } else if (cellType == EMPTY) {
+            freeSlot[index] = freeCount;
+            freeCells[freeCount++] = index;
+        }
+    }
+
+    void revert(const CellWrite& write) {
+        uint8_t current = cells[write.index];
+        cells[write.index] = write.previous;
+        if (write.previous == EMPTY) {
+            // Undo a swap-remove: put the moved cell back at the end
+            int32_t moved = freeCells[write.slot];
+            freeCells[freeCount] = moved;
+            freeSlot[moved] = freeCount;
+            freeCells[write.slot] = write.index;
+            freeSlot[write.index] = write.slot;
+            freeCount++;
+        } else if (current == EMPTY) {
+            freeCount--;
+            freeSlot[write.index] = -1;
+        }
+    }
+
+    uint64_t nextRandom() {
+        if (foodMode == SEARCH_FOOD_DETERMINIZED) {
+            SplitMix64 draw(random ^ (tick * 0xD1B54A32D192ED03ull));
+            return draw.next();
+        }
+        SplitMix64 stream(random);
+        uint64_t value = stream.next();
+        random += 0x9E3779B97F4A7C15ull;
+        return value;
+    }
+
+    void placeFoodAt(Undo& record, int32_t index) {
+        setCell(record, index, FOOD);
+        food = index;
+        needsFood = false;
+    }
+
+public:
+    SearchState(const SearchState&) = delete;
+    SearchState& operator=(const SearchState&) = delete;
+
+    /**
+     * @brief Takes the position of a live game (logic thread, between ticks).
+     *
+     * The game's queued presses are not carried over; the search starts
+     * from its current heading.
+     * @param game A BasicSnakeSimulation over a dense board
+     * @param arena Arena the state and its arrays come from
+     * @param maxDepth Moves that can be outstanding before undo()
+     * @param foodMode How eaten food is replaced
+     * @param seed Seed for the stream or the determinization
+     */
+    template<typename Simulation>
+    static SearchState* fromSimulation(const Simulation& game, ScratchArena& arena, uint32_t maxDepth,
+                                       SearchFoodMode foodMode = SEARCH_FOOD_STREAM, uint64_t seed = 0) {
+        static_assert(!Simulation::BoardType::IS_SPARSE,
+                      "Search states copy the board's byte grid and free list, which a sparse board does not have");
+        const auto& board = game.getBoard();
+        SearchState* state = allocate(arena, board.getCellCount(), maxDepth);
+        span<const uint8_t> grid = board.getCells();
+        memcpy(state->cells, grid.data(), grid.size());
+        memcpy(state->freeCells, board.getFreeCells().data(), sizeof(int32_t) * board.getFreeCellCount());
+        memcpy(state->freeSlot, board.getFreeSlots().data(), sizeof(int32_t) * grid.size());
+
+        SnakeBodyView body = game.getSnake().getBody();
+        memcpy(state->ring, body.first.data(), sizeof(uint32_t) * body.first.size());
+        memcpy(state->ring + body.first.size(), body.second.data(), sizeof(uint32_t) * body.second.size());
+
+        ResumeState resume = game.getResumeState();
+        state->rows = board.getRows();
+        state->cols = board.getCols();
+        state->freeCount = board.getFreeCellCount();
+        state->headSlot = 0;
+        state->length = static_cast<uint32_t>(body.size());
+        state->growthPending = resume.growthPending;
+        state->food = resume.food;
+        state->score = resume.score;
+        state->pointsPerFood = resume.pointsPerFood;
+        state->tick = resume.tick;
+        state->direction = resume.direction;
+        state->gameOver = resume.gameOver;
+        state->needsFood = false;
+        state->gameOverCause = resume.gameOverCause;
+        state->foodMode = foodMode;
+        state->random = seed;
+        return state;
+    }
+
+    /**
+     * @brief Copies this position into an arena, with an empty undo log.
+     * @param maxDepth Undo capacity of the copy; 0 = the same as this state's
+     */
+    SearchState* clone(ScratchArena& arena, uint32_t maxDepth = 0) const {
+        SearchState* copy = allocate(arena, cellCount, maxDepth ? maxDepth : this->maxDepth);
+        memcpy(copy->cells, cells, static_cast<size_t>(cellCount));
+        memcpy(copy->freeCells, freeCells, sizeof(int32_t) * static_cast<size_t>(freeCount));
+        memcpy(copy->freeSlot, freeSlot, sizeof(int32_t) * static_cast<size_t>(cellCount));
+        uint32_t firstSize = min(length, static_cast<uint32_t>(cellCount) - headSlot);
+        memcpy(copy->ring, ring + headSlot, sizeof(uint32_t) * firstSize);
+        memcpy(copy->ring + firstSize, ring, sizeof(uint32_t) * (length - firstSize));
+
+        copy->rows = rows;
+        copy->cols = cols;
+        copy->freeCount = freeCount;
+        copy->headSlot = 0;
+        copy->length = length;
+        copy->growthPending = growthPending;
+        copy->food = food;
+        copy->score = score;
+        copy->pointsPerFood = pointsPerFood;
+        copy->tick = tick;
+        copy->direction = direction;
+        copy->gameOver = gameOver;
+        copy->needsFood = needsFood;
+        copy->gameOverCause = gameOverCause;
+        copy->foodMode = foodMode;
+        copy->random = random;
+        return copy;
+    }
+
+    /**
+     * @brief Plays one tick after pressing `press` (NONE or a reversal keeps the heading).
+     *
+     * A move on a finished game is logged as a no-op, so apply() and
+     * undo() always pair up.
+     * @return True if the game goes on; false if it is over or the undo
+     *         log is full (getDepth() == getMaxDepth()), in which case
+     *         nothing was played
+     */
+    bool apply(Direction press) {
+        if (depth == maxDepth) return false;
+        Undo& record = log[depth++];
+        record.writeCount = 0;
+        record.direction = static_cast<uint8_t>(direction);
+        record.gameOver = gameOver;
+        record.gameOverCause = static_cast<uint8_t>(gameOverCause);
+        record.needsFood = needsFood;
+        record.headSlot = headSlot;
+        record.length = length;
+        record.growthPending = growthPending;
+        record.food = food;
+        record.score = score;
+        record.tick = tick;
+        record.random = random;
+        if (gameOver) return false;
+
+        tick++;
+        bool reverse = (direction == UP && press == DOWN) || (direction == DOWN && press == UP) ||
+                       (direction == LEFT && press == RIGHT) || (direction == RIGHT && press == LEFT);
+        if (press != NONE && !reverse) direction = press;
+
+        int32_t head = static_cast<int32_t>(ring[headSlot]);
+        int32_t r = head / cols;
+        int32_t c = head - r * cols;
+        switch (direction) {
+            case UP:    r--; break;
+            case DOWN:  r++; break;
+            case LEFT:  c--; break;
+            case RIGHT: c++; break;
+            case NONE:  break;
+        }
+        if (r < 0 || r >= rows || c < 0 || c >= cols) {
+            gameOver = true;
+            gameOverCause = HIT_WALL;
+            return false;
+        }
+        int32_t next = r * cols + c;
+        uint8_t target = cells[next];
+        int32_t tail = static_cast<int32_t>(ring[slotAt(length - 1)]);
+        if (target == WALL) {
+            gameOver = true;
+            gameOverCause = HIT_WALL;
+            return false;
+        }
+        if (target == SNAKE && next != head && (growthPending > 0 || next != tail)) {
+            gameOver = true;
+            gameOverCause = HIT_SELF;
+            return false;
+        }
+
+        if (target == FOOD) {
+            growthPending++;
+            score += pointsPerFood;
+            setCell(record, next, EMPTY);
+            food = -1;
+        }
+        if (growthPending > 0) {
+            growthPending--;
+        } else {
+            setCell(record, tail, EMPTY);
+            length--;
+        }
+        headSlot = headSlot == 0 ? static_cast<uint32_t>(cellCount) - 1 : headSlot - 1;
+        record.overwritten = ring[headSlot];
+        ring[headSlot] = static_cast<uint32_t>(next);
+        length++;
+        setCell(record, next, SNAKE);
+
+        if (food < 0) {
+            if (freeCount > 0) {
+                if (foodMode == SEARCH_FOOD_CHANCE) {
+                    needsFood = true;
+                } else {
+                    uint32_t k = static_cast<uint32_t>(((nextRandom() >> 32) * static_cast<uint64_t>(freeCount)) >> 32);
+                    placeFoodAt(record, freeCells[k]);
+                }
+            } else if (growthPending == 0) {
+                gameOver = true;
+                gameOverCause = BOARD_FILLED;
+            }
+        }
+        return !gameOver;
+    }
+
+    /**
+     * @brief Places the food a chance node chose, as part of the last move.
+     * @param index Row-major index of an EMPTY cell, e.g. getFreeCell(k)
+     */
+    void placeFood(int32_t index) {
+        placeFoodAt(log[depth - 1], index);
+    }
+
+    /**
+     * @brief Takes back the last apply(), including any placeFood() after it.
+     */
+    void undo() {
+        const Undo& record = log[--depth];
+        for (int i = record.writeCount - 1; i >= 0; i--) {
+            revert(record.writes[i]);
+        }
+        if (record.headSlot != headSlot) {
+            ring[headSlot] = record.overwritten;
+        }
+        headSlot = record.headSlot;
+        length = record.length;
+        direction = static_cast<Direction>(record.direction);
+        gameOver = record.gameOver != 0;
+        gameOverCause = static_cast<GameOverCause>(record.gameOverCause);
+        needsFood = record.needsFood != 0;
+        growthPending = record.growthPending;
+        food = record.food;
+        score = record.score;
+        tick = record.tick;
+        random = record.random;
+    }
+
+    /**
+     * @brief Re-seeds the food draws, e.g. once per determinization.
+     */
+    void setFoodMode(SearchFoodMode mode, uint64_t seed) {
+        foodMode = mode;
+        random = seed;
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+    int getCell(int index) const { return cells[index]; }
+    int getFreeCellCount() const { return freeCount; }
+    int getFreeCell(int k) const { return freeCells[k]; }
+    uint32_t getHeadIndex() const { return ring[headSlot]; }
+    uint32_t getTailIndex() const { return ring[slotAt(length - 1)]; }
+    /// Segment i of the body, head first
+    uint32_t getSegment(uint32_t i) const { return ring[slotAt(i)]; }
+    size_t getLength() const { return length; }
+    int getPendingGrowth() const { return growthPending; }
+    int32_t getFood() const { return food; }
+    bool getNeedsFood() const { return needsFood; }
+    int getScore() const { return score; }
+    uint64_t getTick() const { return tick; }
+    Direction getDirection() const { return direction; }
+    bool isGameOver() const { return gameOver; }
+    GameOverCause getGameOverCause() const { return gameOverCause; }
+    uint32_t getDepth() const { return depth; }
+    uint32_t getMaxDepth() const { return maxDepth; }
+};
+
+#endif // SEARCHSTATE_H
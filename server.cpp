@@ -0,0 +1,129 @@
+#include "gameServer.h"
+#include <climits>
+#include <csignal>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <sys/resource.h>
+#endif
+
+using namespace std;
+
+static atomic<bool> stopRequested{false};
+
+static void onSignal(int) {
+    stopRequested.store(true);
+}
+
+static void printUsage(const char* program) {
+    cerr << "Usage: " << program << " [options]\n"
+         << "  --bind ADDR          IPv4 address to listen on (default 0.0.0.0)\n"
+         << "  --telnet-port N      Telnet port, 0 to disable (default 2323)\n"
+         << "  --ws-port N          WebSocket port, 0 to disable (default 8080)\n"
+         << "  --max-sessions N     Concurrent sessions before new connections are refused (default 16384)\n"
+         << "  --seed N             Master seed; game g is seeded from stream g of N (reproducible)\n"
+         << "  --profile FILE       Write the profiler report as JSON on exit (build with -DSNAKE_PROFILE;\n"
+         << "                       GET /stats on the WebSocket port serves it live)\n";
+}
+
+/**
+ * @brief Lifts the open-file limit to the hard limit so thousands of sockets fit.
+ */
+static void raiseFileLimit() {
+#ifndef _WIN32
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+#endif
+}
+
+/**
+ * Parses a whole decimal integer in [minValue, maxValue].
+ */
+static bool parseInteger(const string& text, long long minValue, long long maxValue, long long& value) {
+    long long parsed = 0;
+    istringstream in(text);
+    if (!(in >> parsed) || !in.eof() || parsed < minValue || parsed > maxValue) return false;
+    value = parsed;
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    GameConfig config;
+    ServerConfig serverConfig;
+    string profilePath;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        long long number = 0;
+        if (arg == "--bind" && hasValue) {
+            serverConfig.bindAddress = argv[++i];
+        } else if (arg == "--telnet-port" && hasValue) {
+            if (!parseInteger(argv[++i], 0, 65535, number)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            serverConfig.telnetPort = static_cast<uint16_t>(number);
+        } else if (arg == "--ws-port" && hasValue) {
+            if (!parseInteger(argv[++i], 0, 65535, number)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            serverConfig.webSocketPort = static_cast<uint16_t>(number);
+        } else if (arg == "--max-sessions" && hasValue) {
+            if (!parseInteger(argv[++i], 1, INT_MAX, number)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            serverConfig.maxSessions = static_cast<size_t>(number);
+        } else if (arg == "--seed" && hasValue) {
+            if (!parseInteger(argv[++i], 0, UINT32_MAX, number)) {
+                printUsage(argv[0]);
+                return 1;
+            }
+            config.seed = static_cast<uint32_t>(number);
+        } else if (arg == "--profile" && i + 1 < argc) {
+            profilePath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (!SocketApi::startup()) {
+        cerr << "Could not start the socket library\n";
+        return 1;
+    }
+    raiseFileLimit();
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+#ifndef _WIN32
+    signal(SIGPIPE, SIG_IGN);
+#endif
+
+    int status = visitBoardType(config.rows, config.cols, [&](auto board) {
+        using BoardT = typename decltype(board)::type;
+        GameServer<BoardT> server(config, serverConfig);
+        if (!server.open()) {
+            cerr << "Could not listen on " << serverConfig.bindAddress << " (telnet "
+                 << serverConfig.telnetPort << ", websocket " << serverConfig.webSocketPort << ")\n";
+            return 1;
+        }
+        cerr << "Snake server on " << serverConfig.bindAddress << ": telnet " << serverConfig.telnetPort
+             << ", websocket " << serverConfig.webSocketPort << " (" << Poller::backendName() << ")\n";
+        server.run(stopRequested);
+        cerr << "Stopped after " << server.getGamesStarted() << " games\n";
+        return 0;
+    });
+
+    SocketApi::cleanup();
+    if (!profilePath.empty()) {
+        ofstream out(profilePath, ios::trunc);
+        out << Profiler::instance().report().toJson();
+        if (!out) cerr << "Could not write profile to " << profilePath << "\n";
+    }
+    return status;
+}
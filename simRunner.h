@@ -0,0 +1,280 @@
+// simRunner.h
+#ifndef SIMRUNNER_H
+#define SIMRUNNER_H
+
+#include <cmath>
+
+#include "gameLogic.h"
+#include "workPool.h"
+
+// ============================================================================
+// SWEEP SETTINGS AND RESULTS
+// ============================================================================
+
+/**
+ * @brief Settings for a sweep of independent headless episodes.
+ */
+struct SweepConfig {
+    int rows = 20;
+    int cols = 40;
+    int startingLength = 3;
+    int pointsPerFood = 10;
+    Direction initialDirection = RIGHT;
+    uint32_t seed = 1;               ///< Master seed; episode e always gets the same game
+    uint32_t episodes = 100000;
+    int maxEpisodeTicks = 10000;     ///< Truncate episodes after this many ticks; 0 = never
+    uint32_t grain = 32;             ///< Episodes a worker claims at a time
+};
+
+/**
+ * @brief How an episode ended.
+ */
+enum EpisodeEnd {
+    ENDED_WALL = 0,
+    ENDED_SELF = 1,
+    ENDED_FILLED = 2,
+    ENDED_TRUNCATED = 3
+};
+
+constexpr int EPISODE_END_COUNT = 4;
+
+struct EpisodeResult {
+    uint32_t episode;
+    int32_t score;
+    int32_t length;
+    int32_t ticks;
+    EpisodeEnd end;
+};
+
+/**
+ * @brief Running totals over episodes; one per worker, merged at the end.
+ *
+ * Cache-line aligned so workers updating their own copies never share a line.
+ */
+struct alignas(64) SweepStats {
+    uint64_t episodes = 0;
+    uint64_t ticks = 0;
+    uint64_t totalScore = 0;
+    uint64_t totalLength = 0;
+    double scoreSquares = 0;
+    int32_t maxScore = 0;
+    int32_t maxLength = 0;
+    uint64_t ends[EPISODE_END_COUNT] = {};
+
+    void add(const EpisodeResult& result) {
+        episodes++;
+        ticks += static_cast<uint64_t>(result.ticks);
+        totalScore += static_cast<uint64_t>(result.score);
+        totalLength += static_cast<uint64_t>(result.length);
+        scoreSquares += static_cast<double>(result.score) * result.score;
+        maxScore = max(maxScore, result.score);
+        maxLength = max(maxLength, result.length);
+        ends[result.end]++;
+    }
+
+    void merge(const SweepStats& other) {
+        episodes += other.episodes;
+        ticks += other.ticks;
+        totalScore += other.totalScore;
+        totalLength += other.totalLength;
+        scoreSquares += other.scoreSquares;
+        maxScore = max(maxScore, other.maxScore);
+        maxLength = max(maxLength, other.maxLength);
+        for (int i = 0; i < EPISODE_END_COUNT; i++) ends[i] += other.ends[i];
+    }
+
+    double meanScore() const { return episodes ? static_cast<double>(totalScore) / episodes : 0.0; }
+    double meanLength() const { return episodes ? static_cast<double>(totalLength) / episodes : 0.0; }
+    double meanTicks() const { return episodes ? static_cast<double>(ticks) / episodes : 0.0; }
+
+    double scoreStdDev() const {
+        if (episodes < 2) return 0.0;
+        double mean = meanScore();
+        return sqrt(max(0.0, scoreSquares / episodes - mean * mean));
+    }
+};
+
+// ============================================================================
+// PER-WORKER RESOURCES
+// ============================================================================
+
+/**
+ * @brief Bump allocator for per-episode policy scratch.
+ *
+ * Memory comes in blocks that are kept across reset(), so after the first
+ * few episodes a worker's policy allocates nothing. Pointers stay valid
+ * until the next reset().
+ */
+class ScratchArena {
+private:
+    static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    vector<unique_ptr<max_align_t[]>> blocks;
+    vector<size_t> blockSizes;
+    size_t block = 0;
+    size_t used = 0;
+
+public:
+    template<typename T>
+    T* allocate(size_t count) {
+        static_assert(is_trivially_destructible_v<T>, "Arena memory is never destroyed");
+        size_t bytes = (count * sizeof(T) + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+
+        while (block < blocks.size() && used + bytes > blockSizes[block]) {
+            block++;
+            used = 0;
+        }
+        if (block == blocks.size()) {
+            size_t size = max(BLOCK_SIZE, bytes);
+            blocks.push_back(make_unique<max_align_t[]>(size / sizeof(max_align_t) + 1));
+            blockSizes.push_back(size);
+            used = 0;
+        }
+
+        T* result = reinterpret_cast<T*>(reinterpret_cast<unsigned char*>(blocks[block].get()) + used);
+        used += bytes;
+        return result;
+    }
+
+    void reset() {
+        block = 0;
+        used = 0;
+    }
+};
+
+/**
+ * @brief What a policy gets besides the game: its worker's private resources.
+ */
+struct EpisodeContext {
+    unsigned worker;                 ///< Worker running the episode
+    uint32_t episode;                ///< Episode index in [0, SweepConfig::episodes)
+    SplitMix64& rng;                 ///< Reseeded per episode, so results do not depend on scheduling
+    ScratchArena& arena;             ///< Reset before each episode
+};
+
+/**
+ * @brief Baseline policy: keep going, turning at random with probability 1 / turnOdds.
+ */
+struct RandomTurnPolicy {
+    uint32_t turnOdds = 8;
+
+    template<typename Simulation>
+    Direction operator()(const Simulation&, EpisodeContext& context) const {
+        if (context.rng.below(turnOdds) != 0) return NONE;
+        return static_cast<Direction>(context.rng.below(4));
+    }
+};
+
+// ============================================================================
+// SIMULATION RUNNER
+// ============================================================================
+
+/**
+ * @brief Runs a sweep of headless episodes across a WorkStealingPool.
+ *
+ * Every worker owns its simulation, RNG stream, scratch arena and
+ * SweepStats, so the only state shared on the hot path is the pool's
+ * range words. Stats are merged once all workers are done. Episode e is
+ * seeded from (seed, e) alone, so a sweep gives the same results on any
+ * number of threads.
+ *
+ * BoardT selects runtime (`Board`) or compile-time (`FixedBoard<R, C>`)
+ * dimensions and RandomT the food RNG, as for BasicSnakeSimulation.
+ */
+template<typename BoardT = Board, typename RandomT = GameRandom>
+class SimulationRunner {
+public:
+    using Simulation = BasicSnakeSimulation<BoardT, RandomT>;
+
+private:
+    struct alignas(64) Worker {
+        Simulation game;
+        SplitMix64 rng;
+        ScratchArena arena;
+        SweepStats stats;
+    };
+
+    WorkStealingPool& pool;
+    SweepConfig config;
+    unique_ptr<Worker[]> workers;
+
+    // Same derivation as BatchSnakeEnv: stream `episode` of the master seed
+    uint64_t episodeKey(uint32_t episode) const {
+        return deriveStreamKey(config.seed, episode);
+    }
+
+    template<typename Policy>
+    EpisodeResult runEpisode(Worker& worker, unsigned workerIndex, uint32_t episode, Policy& policy) {
+        uint64_t key = episodeKey(episode);
+        worker.game.initialize(config.rows, config.cols, config.startingLength, config.pointsPerFood,
+                               config.initialDirection, static_cast<uint32_t>(key));
+        worker.rng.seed(key ^ 0xD1B54A32D192ED03ull);
+        worker.arena.reset();
+        EpisodeContext context{workerIndex, episode, worker.rng, worker.arena};
+
+        GameDelta delta;
+        int32_t ticks = 0;
+        bool alive = true;
+        while (alive && (config.maxEpisodeTicks <= 0 || ticks < config.maxEpisodeTicks)) {
+            Direction action = policy(static_cast<const Simulation&>(worker.game), context);
+            if (action != NONE) worker.game.setDirection(action);
+            alive = worker.game.step(delta);
+            ticks++;
+        }
+
+        EpisodeEnd end = ENDED_TRUNCATED;
+        switch (worker.game.getGameOverCause()) {
+            case HIT_WALL:     end = ENDED_WALL; break;
+            case HIT_SELF:     end = ENDED_SELF; break;
+            case BOARD_FILLED: end = ENDED_FILLED; break;
+            case NOT_OVER:     break;
+        }
+        return {episode, worker.game.getScore(), static_cast<int32_t>(worker.game.getSnake().getLength()),
+                ticks, end};
+    }
+
+public:
+    SimulationRunner(WorkStealingPool& workPool, const SweepConfig& sweepConfig)
+        : pool(workPool), config(sweepConfig),
+          workers(make_unique<Worker[]>(workPool.getWorkerCount())) {}
+
+    /**
+     * @brief Runs every episode and returns the merged stats.
+     * @param policy Called once per tick as policy(const Simulation&, EpisodeContext&)
+     *               and returning the direction to press (NONE = none); called
+     *               concurrently from all workers, so it must not share mutable state
+     * @param results Optional array of SweepConfig::episodes entries, filled by episode index
+     */
+    template<typename Policy>
+    SweepStats run(Policy&& policy, EpisodeResult* results = nullptr) {
+        for (unsigned w = 0; w < pool.getWorkerCount(); w++) {
+            workers[w].stats = SweepStats();
+        }
+
+        pool.parallelFor(config.episodes, config.grain, [&](uint32_t begin, uint32_t end, unsigned w) {
+            Worker& worker = workers[w];
+            for (uint32_t episode = begin; episode < end; episode++) {
+                EpisodeResult result = runEpisode(worker, w, episode, policy);
+                worker.stats.add(result);
+                if (results) results[episode] = result;
+            }
+        });
+
+        SweepStats total;
+        for (unsigned w = 0; w < pool.getWorkerCount(); w++) {
+            total.merge(workers[w].stats);
+        }
+        return total;
+    }
+
+    /**
+     * @brief One worker's share of the last run (for checking the balance).
+     */
+    const SweepStats& getWorkerStats(unsigned worker) const {
+        return workers[worker].stats;
+    }
+
+    const SweepConfig& getConfig() const { return config; }
+};
+
+#endif // SIMRUNNER_H
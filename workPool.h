@@ -0,0 +1,187 @@
+// workPool.h
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// ============================================================================
+// WORK-STEALING POOL
+// ============================================================================
+
+/**
+ * @brief Persistent thread pool that runs index ranges with work stealing.
+ *
+ * parallelFor() splits [0, count) evenly across the workers. Each worker
+ * claims `grain` indices at a time from the front of its own range; once
+ * that is empty it steals the back half of another worker's range. A
+ * range is one packed 64-bit word (begin:32 | end:32) on its own cache
+ * line, so owners and thieves agree through a single compare-and-swap and
+ * nothing else is shared while work remains.
+ *
+ * The calling thread takes part as worker 0, so a pool of N workers starts
+ * N - 1 threads. parallelFor() calls must not overlap.
+ */
+class WorkStealingPool {
+private:
+    struct alignas(64) WorkerRange {
+        atomic<uint64_t> range{0};
+    };
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static uint32_t beginOf(uint64_t range) { return static_cast<uint32_t>(range >> 32); }
+    static uint32_t endOf(uint64_t range) { return static_cast<uint32_t>(range); }
+
+    unsigned workerCount;
+    unique_ptr<WorkerRange[]> ranges;
+    vector<thread> threads;
+
+    // Current job, type-erased so the workers need no std::function
+    void (*invoke)(void* body, uint32_t begin, uint32_t end, unsigned worker);
+    void* body;
+    uint32_t grain;
+
+    alignas(64) atomic<uint64_t> generation;
+    alignas(64) atomic<unsigned> running;
+    atomic<bool> shuttingDown;
+
+    /**
+     * @brief Takes up to `grain` indices from the front of a worker's own range.
+     */
+    bool claim(unsigned worker, uint32_t& begin, uint32_t& end) {
+        atomic<uint64_t>& own = ranges[worker].range;
+        uint64_t current = own.load(memory_order_acquire);
+        while (true) {
+            uint32_t first = beginOf(current);
+            uint32_t last = endOf(current);
+            if (first >= last) return false;
+            uint32_t taken = min(grain, last - first);
+            if (own.compare_exchange_weak(current, pack(first + taken, last), memory_order_acq_rel)) {
+                begin = first;
+                end = first + taken;
+                return true;
+            }
+        }
+    }
+
+    /**
+     * @brief Moves the back half of some other worker's range into this worker's.
+     */
+    bool steal(unsigned worker) {
+        for (unsigned k = 1; k < workerCount; k++) {
+            atomic<uint64_t>& victim = ranges[(worker + k) % workerCount].range;
+            uint64_t current = victim.load(memory_order_acquire);
+            while (true) {
+                uint32_t first = beginOf(current);
+                uint32_t last = endOf(current);
+                if (first >= last) break;
+                uint32_t middle = first + (last - first) / 2;
+                if (victim.compare_exchange_weak(current, pack(first, middle), memory_order_acq_rel)) {
+                    ranges[worker].range.store(pack(middle, last), memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    void runShare(unsigned worker) {
+        uint32_t begin, end;
+        do {
+            while (claim(worker, begin, end)) {
+                invoke(body, begin, end, worker);
+            }
+        } while (steal(worker));
+    }
+
+    void workerLoop(unsigned worker) {
+        uint64_t seen = 0;
+        while (true) {
+            generation.wait(seen, memory_order_acquire);
+            seen = generation.load(memory_order_acquire);
+            if (shuttingDown.load(memory_order_acquire)) return;
+
+            runShare(worker);
+            if (running.fetch_sub(1, memory_order_acq_rel) == 1) {
+                running.notify_all();
+            }
+        }
+    }
+
+public:
+    /**
+     * @param workers Worker count including the calling thread; 0 = one per hardware thread
+     */
+    explicit WorkStealingPool(unsigned workers = 0)
+        : workerCount(workers ? workers : max(1u, thread::hardware_concurrency())),
+          ranges(make_unique<WorkerRange[]>(workerCount)),
+          invoke(nullptr), body(nullptr), grain(1),
+          generation(0), running(0), shuttingDown(false) {
+        threads.reserve(workerCount - 1);
+        for (unsigned worker = 1; worker < workerCount; worker++) {
+            threads.emplace_back(&WorkStealingPool::workerLoop, this, worker);
+        }
+    }
+
+    ~WorkStealingPool() {
+        shuttingDown.store(true, memory_order_release);
+        generation.fetch_add(1, memory_order_acq_rel);
+        generation.notify_all();
+        for (thread& t : threads) {
+            t.join();
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned getWorkerCount() const { return workerCount; }
+
+    /**
+     * @brief Runs `body(begin, end, worker)` over disjoint chunks covering [0, count).
+     *
+     * Returns once every index has been processed. `worker` is in
+     * [0, getWorkerCount()) and identifies the thread, so bodies can keep
+     * per-worker state without synchronization.
+     * @param count Number of indices
+     * @param grainSize Indices claimed per step (at least 1)
+     * @param task Callable taking (uint32_t begin, uint32_t end, unsigned worker)
+     */
+    template<typename Body>
+    void parallelFor(uint32_t count, uint32_t grainSize, Body&& task) {
+        if (count == 0) return;
+
+        grain = max(grainSize, 1u);
+        body = const_cast<void*>(static_cast<const void*>(&task));
+        invoke = [](void* erased, uint32_t begin, uint32_t end, unsigned worker) {
+            (*static_cast<remove_reference_t<Body>*>(erased))(begin, end, worker);
+        };
+
+        for (unsigned worker = 0; worker < workerCount; worker++) {
+            uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(count) * worker / workerCount);
+            uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(count) * (worker + 1) / workerCount);
+            ranges[worker].range.store(pack(begin, end), memory_order_relaxed);
+        }
+
+        running.store(workerCount - 1, memory_order_relaxed);
+        generation.fetch_add(1, memory_order_acq_rel);
+        generation.notify_all();
+
+        runShare(0);
+
+        for (unsigned left = running.load(memory_order_acquire); left != 0;
+             left = running.load(memory_order_acquire)) {
+            running.wait(left, memory_order_acquire);
+        }
+    }
+};
+
+#endif // WORKPOOL_H